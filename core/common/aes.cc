@@ -67,6 +67,58 @@ void AES::ecb_enc_block(const block& plaintext, block& cyphertext) const {
     cyphertext = _mm_aesenclast_si128(cyphertext, _round_key[10]);
 }
 
+// one aes round on 8 blocks, interleaved to keep the aes unit busy
+static inline void aesenc8(block* b, const block& key) {
+    b[0] = _mm_aesenc_si128(b[0], key);
+    b[1] = _mm_aesenc_si128(b[1], key);
+    b[2] = _mm_aesenc_si128(b[2], key);
+    b[3] = _mm_aesenc_si128(b[3], key);
+    b[4] = _mm_aesenc_si128(b[4], key);
+    b[5] = _mm_aesenc_si128(b[5], key);
+    b[6] = _mm_aesenc_si128(b[6], key);
+    b[7] = _mm_aesenc_si128(b[7], key);
+}
+
+void AES::ctr_enc_blocks(uint64_t ctr, size_t block_num,
+                         void* cyphertext) const {
+    const size_t group_num = block_num / 8;
+    auto out = reinterpret_cast<block*>(cyphertext);
+
+#pragma omp parallel for num_threads(4) if (group_num > 0x400)
+    for (size_t g = 0; g < group_num; ++g) {
+        const block k0 = _round_key[0];
+        const int64_t c = ctr + g * 8;
+        block b[8] = {
+            _mm_xor_si128(_mm_cvtsi64_si128(c), k0),
+            _mm_xor_si128(_mm_cvtsi64_si128(c + 1), k0),
+            _mm_xor_si128(_mm_cvtsi64_si128(c + 2), k0),
+            _mm_xor_si128(_mm_cvtsi64_si128(c + 3), k0),
+            _mm_xor_si128(_mm_cvtsi64_si128(c + 4), k0),
+            _mm_xor_si128(_mm_cvtsi64_si128(c + 5), k0),
+            _mm_xor_si128(_mm_cvtsi64_si128(c + 6), k0),
+            _mm_xor_si128(_mm_cvtsi64_si128(c + 7), k0),
+        };
+        aesenc8(b, _round_key[1]);
+        aesenc8(b, _round_key[2]);
+        aesenc8(b, _round_key[3]);
+        aesenc8(b, _round_key[4]);
+        aesenc8(b, _round_key[5]);
+        aesenc8(b, _round_key[6]);
+        aesenc8(b, _round_key[7]);
+        aesenc8(b, _round_key[8]);
+        aesenc8(b, _round_key[9]);
+        for (size_t j = 0; j < 8; ++j) {
+            _mm_storeu_si128(out + g * 8 + j,
+                             _mm_aesenclast_si128(b[j], _round_key[10]));
+        }
+    }
+
+    for (size_t i = group_num * 8; i < block_num; ++i) {
+        _mm_storeu_si128(out + i,
+                         ecb_enc_block(_mm_cvtsi64_si128(ctr + i)));
+    }
+}
+
 #else
 // openssl aes
 void AES::set_key(const block& user_key) {
@@ -80,6 +132,16 @@ void AES::ecb_enc_block(const block& plaintext, block& cyphertext) const {
                 reinterpret_cast<unsigned char*>(&cyphertext),
                 &_aes_key);
 }
+
+void AES::ctr_enc_blocks(uint64_t ctr, size_t block_num,
+                         void* cyphertext) const {
+    auto out = reinterpret_cast<block*>(cyphertext);
+#pragma omp parallel for num_threads(4) if (block_num > 0x2000)
+    for (size_t i = 0; i < block_num; ++i) {
+        _mm_storeu_si128(out + i,
+                         ecb_enc_block(_mm_cvtsi64_si128(ctr + i)));
+    }
+}
 #endif
 
 void AES::ecb_enc_blocks(const block* plaintexts, size_t block_num,
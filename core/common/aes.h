@@ -14,6 +14,9 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+
 #include <emmintrin.h>
 
 #ifndef USE_AES_NI
@@ -42,6 +45,11 @@ public:
 
     void ecb_enc_blocks(const block* plaintexts, size_t block_num,
                         block* ciphertext) const;
+
+    // encrypt counters ctr, ctr + 1, ... as low 64 bits of blocks,
+    // cyphertext need not be aligned
+    void ctr_enc_blocks(uint64_t ctr, size_t block_num,
+                        void* cyphertext) const;
 private:
 #ifdef USE_AES_NI
     block _round_key[11];
@@ -17,6 +17,7 @@
 #include <chrono>
 #include <cstring>
 #include <iostream>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -57,6 +58,24 @@ TEST(aes, base_test) {
     EXPECT_TRUE(equals(c, c_));
 }
 
+TEST(aes, ctr_test) {
+    block k = _mm_set_epi64x(1, 2);
+
+    AES aes(k);
+
+    // not a multiple of interleaved group, unaligned output
+    const size_t num = 37;
+    std::vector<char> buf(num * sizeof(block) + 1);
+
+    aes.ctr_enc_blocks(5, num, buf.data() + 1);
+
+    for (size_t i = 0; i < num; ++i) {
+        block c_;
+        std::memcpy(&c_, buf.data() + 1 + i * sizeof(block), sizeof(block));
+        EXPECT_TRUE(equals(aes.ecb_enc_block(_mm_cvtsi64_si128(5 + i)), c_));
+    }
+}
+
 const size_t bench_size = 0x10000;
 
 block p[bench_size];
@@ -84,4 +103,20 @@ TEST(aes, bench) {
     std::cerr << d.count() * 1.0 / (rep * bench_size) << " ns per op\n";
 }
 
+TEST(aes, ctr_bench) {
+    block k = _mm_set_epi64x(1, 2);
+
+    AES aes(k);
+
+    const size_t rep = 0x100;
+
+    auto t0 = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < rep; ++i) {
+        aes.ctr_enc_blocks(i * bench_size, bench_size, c);
+    }
+    auto t1 = std::chrono::high_resolution_clock::now();
+    auto d = std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0);
+    std::cerr << d.count() * 1.0 / (rep * bench_size) << " ns per op\n";
+}
+
 } // namespace common
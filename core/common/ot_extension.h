@@ -15,6 +15,7 @@
 #pragma once
 
 #include <array>
+#include <memory>
 #include <vector>
 
 #include "prng.h"
@@ -30,6 +31,10 @@ template <typename T> class OTExtBase {
 public:
   static const size_t _s_ot_ext_buffer_size = 0x10000;
 
+  // a matrix generator gives one block per 128 ot instances,
+  // a few blocks of buffer are enough
+  static const size_t _s_matrix_gen_buffer_size = 8;
+
   // bit size of T
   static const size_t _s_ot_size = sizeof(T) * 8;
 
@@ -53,11 +58,17 @@ public:
 
 template <typename T> class OTExtSender : public OTExtBase<T> {
   using OTExtBase<T>::_s_ot_ext_buffer_size;
+  using OTExtBase<T>::_s_matrix_gen_buffer_size;
   using OTExtBase<T>::_s_ot_size;
   using OTExtBase<T>::_s_block_bit_size;
   using OTExtBase<T>::_s_scale;
 
 public:
+  // buffer_size: num of ot instances generated ahead by
+  // get_ot_instance(), the buffer is allocated on first use.
+  // it must match that of the receiver
+  explicit OTExtSender(size_t buffer_size = _s_ot_ext_buffer_size);
+
   T _choices;
 
   void init(const T &_choices, const std::vector<block> &msgs,
@@ -70,9 +81,11 @@ public:
   template <class U> void fill_ot_buffer(U &send_msg);
 
 private:
-  std::array<PseudorandomNumberGenerator, _s_ot_size> _matrix_gen;
+  std::vector<std::unique_ptr<PseudorandomNumberGenerator>> _matrix_gen;
+
+  const size_t _buffer_size;
 
-  std::array<T, _s_ot_ext_buffer_size> _send_msg;
+  std::vector<T> _send_msg;
 
   void fill_ot_buffer();
 
@@ -81,11 +94,15 @@ private:
 
 template <typename T> class OTExtReceiver : public OTExtBase<T> {
   using OTExtBase<T>::_s_ot_ext_buffer_size;
+  using OTExtBase<T>::_s_matrix_gen_buffer_size;
   using OTExtBase<T>::_s_ot_size;
   using OTExtBase<T>::_s_block_bit_size;
   using OTExtBase<T>::_s_scale;
 
 public:
+  // buffer_size: same as that of OTExtSender
+  explicit OTExtReceiver(size_t buffer_size = _s_ot_ext_buffer_size);
+
   void init(const std::vector<std::array<block, 2>> &msgs,
             bool init_buffer = false);
 
@@ -96,10 +113,12 @@ public:
   template <class U> void fill_ot_buffer(U &recv_msg);
 
 private:
-  std::array<std::array<PseudorandomNumberGenerator, 2>, _s_ot_size>
+  std::vector<std::array<std::unique_ptr<PseudorandomNumberGenerator>, 2>>
       _matrix_gen;
 
-  std::array<std::array<T, 2>, _s_ot_ext_buffer_size> _recv_msg;
+  const size_t _buffer_size;
+
+  std::vector<std::array<T, 2>> _recv_msg;
 
   void fill_ot_buffer();
 
@@ -22,6 +22,31 @@
 
 namespace common {
 
+template <typename T>
+OTExtSender<T>::OTExtSender(size_t buffer_size)
+    : _matrix_gen(_s_ot_size), _buffer_size(buffer_size), _now_idx(0) {
+  if (buffer_size == 0) {
+    throw std::invalid_argument("ot ext error: "
+                                "buffer size should be positive");
+  }
+  for (auto &gen : _matrix_gen) {
+    gen.reset(new PseudorandomNumberGenerator(_s_matrix_gen_buffer_size));
+  }
+}
+
+template <typename T>
+OTExtReceiver<T>::OTExtReceiver(size_t buffer_size)
+    : _matrix_gen(_s_ot_size), _buffer_size(buffer_size), _now_idx(0) {
+  if (buffer_size == 0) {
+    throw std::invalid_argument("ot ext error: "
+                                "buffer size should be positive");
+  }
+  for (auto &gen : _matrix_gen) {
+    gen[0].reset(new PseudorandomNumberGenerator(_s_matrix_gen_buffer_size));
+    gen[1].reset(new PseudorandomNumberGenerator(_s_matrix_gen_buffer_size));
+  }
+}
+
 template <typename T>
 void OTExtSender<T>::init(const T &choices, const std::vector<block> &msgs,
                           bool init_buffer) {
@@ -35,13 +60,13 @@ void OTExtSender<T>::init(const T &choices, const std::vector<block> &msgs,
 
   size_t idx = 0;
   for (auto &gen : _matrix_gen) {
-    gen.set_seed(msgs[idx++]);
+    gen->set_seed(msgs[idx++]);
   }
 
   if (init_buffer) {
     fill_ot_buffer();
   } else {
-    _now_idx = _s_ot_ext_buffer_size;
+    _now_idx = _send_msg.size();
   }
 }
 
@@ -55,14 +80,14 @@ void OTExtReceiver<T>::init(const std::vector<std::array<block, 2>> &msgs,
 
   size_t idx = 0;
   for (auto &gen : _matrix_gen) {
-    gen[0].set_seed(msgs[idx][0]);
-    gen[1].set_seed(msgs[idx++][1]);
+    gen[0]->set_seed(msgs[idx][0]);
+    gen[1]->set_seed(msgs[idx++][1]);
   }
 
   if (init_buffer) {
     fill_ot_buffer();
   } else {
-    _now_idx = _s_ot_ext_buffer_size;
+    _now_idx = _recv_msg.size();
   }
 }
 
@@ -78,7 +103,7 @@ void OTExtSender<T>::fill_ot_buffer(U &send_msg) {
   for (size_t msg_idx = 0; msg_idx < send_msg.size();) {
     size_t gen_idx = 0;
     for (auto &slot : q_block_view) {
-      slot = _matrix_gen[gen_idx++].template get<block>();
+      slot = _matrix_gen[gen_idx++]->template get<block>();
     }
 
     for (auto &sub_mat : q) {
@@ -95,6 +120,7 @@ void OTExtSender<T>::fill_ot_buffer(U &send_msg) {
 }
 
 template <typename T> void OTExtSender<T>::fill_ot_buffer() {
+  _send_msg.resize(_buffer_size);
   fill_ot_buffer(_send_msg);
   _now_idx = 0;
 }
@@ -113,8 +139,8 @@ void OTExtReceiver<T>::fill_ot_buffer(U &recv_msg) {
   // 128 OT instances in one batch
   for (size_t msg_idx = 0; msg_idx < recv_msg.size();) {
     for (size_t gen_idx = 0; gen_idx < _s_ot_size; ++gen_idx) {
-      t0_block_view[gen_idx] = _matrix_gen[gen_idx][0].template get<block>();
-      t1_block_view[gen_idx] = _matrix_gen[gen_idx][1].template get<block>();
+      t0_block_view[gen_idx] = _matrix_gen[gen_idx][0]->template get<block>();
+      t1_block_view[gen_idx] = _matrix_gen[gen_idx][1]->template get<block>();
     }
 
     for (auto &sub_mat : t[0]) {
@@ -134,12 +160,13 @@ void OTExtReceiver<T>::fill_ot_buffer(U &recv_msg) {
 }
 
 template <typename T> void OTExtReceiver<T>::fill_ot_buffer() {
+  _recv_msg.resize(_buffer_size);
   fill_ot_buffer(_recv_msg);
   _now_idx = 0;
 }
 
 template <typename T> T OTExtSender<T>::get_ot_instance() {
-  if (_now_idx == _s_ot_ext_buffer_size) {
+  if (_now_idx == _send_msg.size()) {
     fill_ot_buffer();
   }
 
@@ -149,7 +176,7 @@ template <typename T> T OTExtSender<T>::get_ot_instance() {
 template <typename T> void OTExtSender<T>::get_ot_instance(TensorBlock* ot_msg) {
   auto numel = ot_msg->numel() / 2;
   for (int i = 0; i < numel; ++i) {
-    if (_now_idx == _s_ot_ext_buffer_size) {
+    if (_now_idx == _send_msg.size()) {
       fill_ot_buffer();
     }
     *(reinterpret_cast<block*>(ot_msg->data()) + i) = _send_msg[_now_idx++];
@@ -157,7 +184,7 @@ template <typename T> void OTExtSender<T>::get_ot_instance(TensorBlock* ot_msg)
 }
 
 template <typename T> std::array<T, 2> OTExtReceiver<T>::get_ot_instance() {
-  if (_now_idx == _s_ot_ext_buffer_size) {
+  if (_now_idx == _recv_msg.size()) {
     fill_ot_buffer();
   }
 
@@ -167,7 +194,7 @@ template <typename T> std::array<T, 2> OTExtReceiver<T>::get_ot_instance() {
 template <typename T> void OTExtReceiver<T>::get_ot_instance(TensorBlock* ot_msg0,
                                                         TensorBlock* ot_msg1) {
   for (int i = 0; i < ot_msg0->numel() / 2; ++i) {
-    if (_now_idx == _s_ot_ext_buffer_size) {
+    if (_now_idx == _recv_msg.size()) {
       fill_ot_buffer();
     }
     *(reinterpret_cast<block*>(ot_msg0->data()) + i) = _recv_msg[_now_idx][0];
@@ -132,4 +132,22 @@ TEST_F(OTtest, ot_ext_test2) {
   }
 }
 
+TEST_F(OTtest, ot_ext_small_buffer_test) {
+  // refills of buffer not aligned to 128 instances
+  OTExtSender<Block512> sender(100);
+  OTExtReceiver<Block512> receiver(100);
+
+  sender.init(_choices_blk, _s_np_ot_receiver->_msgs);
+  receiver.init(_s_np_ot_sender->_msgs);
+
+  for (size_t i = 0; i < _s_loop; ++i) {
+    auto q = sender.get_ot_instance();
+    auto t = receiver.get_ot_instance();
+
+    auto rhs = q ^ ((t[0] ^ t[1]) & _choices_blk);
+    bool res = blk_eq(t[0], rhs);
+    ASSERT_TRUE(res);
+  }
+}
+
 } // namespace common
@@ -14,6 +14,9 @@
 
 #include "paddle_tensor.h"
 
+#include <functional>
+#include <numeric>
+
 namespace common {
 
 std::shared_ptr<TensorAdapter<int64_t>>
@@ -35,4 +38,85 @@ PaddleTensorFactory::create_uint8_t(const std::vector<size_t> &shape) {
   return ret;
 }
 
+const size_t PooledPaddleTensorFactory::SIZE_CLASS_NUM;
+
+template <typename T>
+std::shared_ptr<TensorAdapter<T>>
+PooledPaddleTensorFactory::create_pooled(const std::vector<size_t> &shape) {
+  size_t numel = std::accumulate(shape.begin(), shape.end(), (size_t)1,
+                                 std::multiplies<size_t>());
+  size_t size_class = 0;
+  while (((size_t)1 << size_class) < numel) {
+    ++size_class;
+  }
+
+  std::unique_ptr<PaddleTensor<T>> tensor;
+  {
+    std::lock_guard<std::mutex> lock(_pool->mutex);
+    auto &free_list =
+        std::get<FreeLists<T>>(_pool->free_lists)[size_class];
+    if (!free_list.empty()) {
+      tensor = std::move(free_list.back());
+      free_list.pop_back();
+    }
+  }
+  if (!tensor) {
+    tensor.reset(new PaddleTensor<T>(_device_ctx));
+  }
+  tensor->scaling_factor() = 0;
+
+  std::vector<int64_t> shape_(shape.cbegin(), shape.cend());
+  paddle::framework::DDim dim(shape_.data(), shape_.size());
+  // request the whole class so that the buffer fits any shape of it,
+  // a recycled buffer is large enough and kept
+  const T *data = tensor->mutable_paddle_tensor()->template mutable_data<T>(
+      dim, _device_ctx->GetPlace(), sizeof(T) << size_class);
+
+  std::weak_ptr<Pool> pool = _pool;
+  return std::shared_ptr<TensorAdapter<T>>(
+      tensor.release(), [pool, size_class, data](PaddleTensor<T> *ptr) {
+        std::unique_ptr<PaddleTensor<T>> tensor(ptr);
+        auto pool_ = pool.lock();
+        if (!pool_) {
+          return;
+        }
+        // recycle only if the buffer given out is still solely owned
+        auto &t = *tensor->mutable_paddle_tensor();
+        if (!t.IsInitialized() || t.Holder().use_count() != 1 ||
+            t.template data<T>() != data) {
+          return;
+        }
+        std::lock_guard<std::mutex> lock(pool_->mutex);
+        std::get<FreeLists<T>>(pool_->free_lists)[size_class].emplace_back(
+            std::move(tensor));
+      });
+}
+
+std::shared_ptr<TensorAdapter<int64_t>>
+PooledPaddleTensorFactory::create_int64_t(const std::vector<size_t> &shape) {
+  return create_pooled<int64_t>(shape);
+}
+
+std::shared_ptr<TensorAdapter<int64_t>>
+PooledPaddleTensorFactory::create_int64_t() {
+  return std::make_shared<PaddleTensor<int64_t>>(_device_ctx);
+}
+
+std::shared_ptr<TensorAdapter<uint8_t>>
+PooledPaddleTensorFactory::create_uint8_t(const std::vector<size_t> &shape) {
+  return create_pooled<uint8_t>(shape);
+}
+
+size_t PooledPaddleTensorFactory::pooled_num() const {
+  std::lock_guard<std::mutex> lock(_pool->mutex);
+  size_t num = 0;
+  for (auto &free_list : std::get<FreeLists<int64_t>>(_pool->free_lists)) {
+    num += free_list.size();
+  }
+  for (auto &free_list : std::get<FreeLists<uint8_t>>(_pool->free_lists)) {
+    num += free_list.size();
+  }
+  return num;
+}
+
 } // namespace common
@@ -14,6 +14,10 @@
 
 #pragma once
 
+#include <array>
+#include <memory>
+#include <mutex>
+#include <tuple>
 #include <vector>
 
 #include "paddle/fluid/framework/ddim.h"
@@ -195,6 +199,60 @@ private:
   const paddle::platform::DeviceContext *_device_ctx;
 };
 
+// A tensor factory recycling tensors and their buffers, installed by
+// ContextHolder for each op to save allocations of temporaries.
+// buffers fall into power-of-2 size classes, a tensor released by its
+// last owner goes to the free list of its class and is handed out again
+// by a later create of the same class. tensors whose buffer is shared
+// with others, e.g. by slice(), are freed instead. free lists are
+// released in bulk when the factory is destructed, tensors outliving
+// the factory are freed as usual.
+class PooledPaddleTensorFactory : public TensorAdapterFactory {
+public:
+  PooledPaddleTensorFactory(const paddle::platform::DeviceContext *device_ctx)
+      : _device_ctx(device_ctx), _pool(std::make_shared<Pool>()) {}
+
+  virtual ~PooledPaddleTensorFactory() = default;
+
+  std::shared_ptr<TensorAdapter<int64_t>>
+  create_int64_t(const std::vector<size_t> &shape) override;
+
+  std::shared_ptr<TensorAdapter<uint8_t>>
+  create_uint8_t(const std::vector<size_t> &shape) override;
+
+  // not pooled, as it holds no buffer yet
+  std::shared_ptr<TensorAdapter<int64_t>> create_int64_t() override;
+
+  const paddle::platform::DeviceContext *device_ctx() const {
+    return _device_ctx;
+  }
+
+  // num of tensors in free lists
+  size_t pooled_num() const;
+
+private:
+  // size class c holds buffers of 2^c elements
+  static const size_t SIZE_CLASS_NUM = 64;
+
+  template <typename T>
+  using FreeLists =
+      std::array<std::vector<std::unique_ptr<PaddleTensor<T>>>, SIZE_CLASS_NUM>;
+
+  struct Pool {
+    // tensors may be released by other threads
+    std::mutex mutex;
+    std::tuple<FreeLists<int64_t>, FreeLists<uint8_t>> free_lists;
+  };
+
+  template <typename T>
+  std::shared_ptr<TensorAdapter<T>>
+  create_pooled(const std::vector<size_t> &shape);
+
+  const paddle::platform::DeviceContext *_device_ctx;
+
+  std::shared_ptr<Pool> _pool;
+};
+
 } // namespace common
 
 #include "paddle_tensor_impl.h"
@@ -47,6 +47,36 @@ TEST_F(PaddleTensorTest, factory_test) {
     EXPECT_NO_THROW(_tensor_factory->template create<int64_t>(shape));
 }
 
+TEST_F(PaddleTensorTest, pooled_factory_test) {
+    auto factory = std::make_shared<PooledPaddleTensorFactory>(&_cpu_ctx);
+    auto pt0 = factory->template create<int64_t>({ 2, 3 });
+    pt0->scaling_factor() = SCALING_FACTOR;
+    const int64_t* data = pt0->data();
+    pt0.reset();
+    EXPECT_EQ(1u, factory->pooled_num());
+
+    // same size class, buffer recycled
+    auto pt1 = factory->template create<int64_t>({ 7 });
+    EXPECT_EQ(data, pt1->data());
+    EXPECT_EQ(7u, pt1->numel());
+    EXPECT_EQ(0u, pt1->scaling_factor());
+    EXPECT_EQ(0u, factory->pooled_num());
+
+    // buffer shared by slice is not recycled
+    auto pt2 = factory->template create<int64_t>({ 2, 3 });
+    pt1->slice(0, 1, pt2.get());
+    pt1.reset();
+    EXPECT_EQ(0u, factory->pooled_num());
+    pt2.reset();
+    EXPECT_EQ(0u, factory->pooled_num());
+
+    // tensors outliving factory are freed as usual
+    auto pt3 = factory->template create<uint8_t>({ 100 });
+    factory.reset();
+    pt3->data()[99] = 1;
+    EXPECT_NO_THROW(pt3.reset());
+}
+
 TEST_F(PaddleTensorTest, ctor_test) {
     Tensor t;
     // t holds no memory
@@ -14,12 +14,24 @@
 
 #include "prng.h"
 
+#include <algorithm>
 #include <cstring>
+#include <stdexcept>
 
 namespace common {
 
-PseudorandomNumberGenerator::PseudorandomNumberGenerator(const block &seed)
-    : _ctr(0), _now_byte(0) {
+const size_t PseudorandomNumberGenerator::_s_default_buffer_size;
+
+PseudorandomNumberGenerator::PseudorandomNumberGenerator(size_t buffer_size)
+    : _buffer_size(buffer_size), _ctr(0), _now_byte(0) {
+  if (buffer_size == 0) {
+    throw std::invalid_argument("prng error: buffer size should be positive");
+  }
+}
+
+PseudorandomNumberGenerator::PseudorandomNumberGenerator(const block &seed,
+                                                         size_t buffer_size)
+    : PseudorandomNumberGenerator(buffer_size) {
   set_seed(seed);
 }
 
@@ -31,31 +43,39 @@ void PseudorandomNumberGenerator::set_seed(const block &b) {
 }
 
 void PseudorandomNumberGenerator::refill_buffer() {
-  for (auto &ctr : _ctr64) {
-    ctr = _mm_cvtsi64_si128(_ctr++);
-  }
-
-  _aes.ecb_enc_blocks(_ctr64.data(), _ctr64.size(), _buffer.data());
+  _buffer.resize(_buffer_size);
+  _aes.ctr_enc_blocks(_ctr, _buffer.size(), _buffer.data());
+  _ctr += _buffer.size();
 
   _now_byte = 0;
 }
 
 void PseudorandomNumberGenerator::get_array(void *res, size_t len) {
-  std::array<uint8_t, _s_byte_capacity> &view =
-      *reinterpret_cast<std::array<uint8_t, _s_byte_capacity> *>(&_buffer);
-
-  for (size_t write = 0; len > 0;) {
-    auto step = std::min(len, _s_byte_capacity - _now_byte);
-    std::memcpy(reinterpret_cast<char *>(res) + write, view.data() + _now_byte,
-                step);
-
-    write += step;
-    _now_byte += step;
-    len -= step;
-    if (_now_byte == _s_byte_capacity) {
-      refill_buffer();
-    }
+  if (_buffer.empty()) {
+    throw std::logic_error("prng error: draw before set_seed");
+  }
+  auto dst = reinterpret_cast<char *>(res);
+  auto buffer = reinterpret_cast<const char *>(_buffer.data());
+
+  auto step = std::min(len, byte_capacity() - _now_byte);
+  std::memcpy(dst, buffer + _now_byte, step);
+  _now_byte += step;
+  if (_now_byte < byte_capacity()) {
+    return;
   }
+  dst += step;
+  len -= step;
+
+  // buffer used up, the stream goes on with block _ctr
+  size_t block_num = len / sizeof(block);
+  _aes.ctr_enc_blocks(_ctr, block_num, dst);
+  _ctr += block_num;
+  dst += block_num * sizeof(block);
+  len -= block_num * sizeof(block);
+
+  refill_buffer();
+  std::memcpy(dst, _buffer.data(), len);
+  _now_byte = len;
 }
 
 template <>
@@ -64,4 +84,11 @@ bool PseudorandomNumberGenerator::get<bool>() {
     get_array(&data, sizeof(data));
     return data & 1;
 }
+
+template <>
+void PseudorandomNumberGenerator::fill<bool>(bool *dst, size_t n) {
+  for (size_t i = 0; i < n; ++i) {
+    dst[i] = get<bool>();
+  }
+}
 } // namespace common
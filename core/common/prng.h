@@ -14,7 +14,8 @@
 
 #pragma once
 
-#include <array>
+#include <cstddef>
+#include <vector>
 
 #include "aes.h"
 
@@ -24,9 +25,14 @@ class PseudorandomNumberGenerator {
 
 public:
 
-    PseudorandomNumberGenerator() = default;
+    // buffer_size: num of blocks generated ahead, the stream does not
+    // depend on it. bulk requests bypass the buffer, a small one only
+    // costs more refills of get<T>()
+    explicit PseudorandomNumberGenerator(
+        size_t buffer_size = _s_default_buffer_size);
 
-    PseudorandomNumberGenerator(const block &seed);
+    PseudorandomNumberGenerator(const block &seed,
+                                size_t buffer_size = _s_default_buffer_size);
 
     PseudorandomNumberGenerator(
         const PseudorandomNumberGenerator &other) = delete;
@@ -43,8 +49,16 @@ public:
         return data;
     }
 
+    // bytes past the buffer are encrypted into res directly,
+    // throws std::logic_error if not seeded yet
     void get_array(void* res, size_t len);
 
+    // same values as n calls of get<T>()
+    template <typename T>
+    void fill(T* dst, size_t n) {
+        get_array(dst, n * sizeof(T));
+    }
+
     // for std::shuffle
     typedef uint64_t result_type;
 
@@ -60,16 +74,19 @@ public:
         return get<uint64_t>();
     }
 
-private:
+    // 16KB
+    static const size_t _s_default_buffer_size = 0x400;
 
-    // buffer num for aes cipher
-    static const size_t _s_buffer_size = 0x10000;
+    size_t buffer_size() const { return _buffer_size; }
 
-    static const size_t _s_byte_capacity = _s_buffer_size * sizeof(block);
+private:
 
-    std::array<block, _s_buffer_size> _buffer;
+    size_t byte_capacity() const { return _buffer_size * sizeof(block); }
 
-    std::array<block, _s_buffer_size> _ctr64;
+    const size_t _buffer_size;
+
+    // allocated when seeded, empty means unseeded
+    std::vector<block> _buffer;
 
     uint64_t _ctr;
 
@@ -79,5 +96,12 @@ private:
 
     void refill_buffer();
 };
+
+template <>
+bool PseudorandomNumberGenerator::get<bool>();
+
+template <>
+void PseudorandomNumberGenerator::fill<bool>(bool* dst, size_t n);
+
 } // namespace common
 
@@ -0,0 +1,116 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "prng.h"
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "utils.h"
+
+namespace common {
+
+TEST(prng, fill_test) {
+    block seed = _mm_set_epi64x(3, 4);
+
+    PseudorandomNumberGenerator prng0(seed);
+    PseudorandomNumberGenerator prng1(seed);
+
+    // small and buffer spanning fills, with unaligned offsets
+    const size_t sizes[] = { 1, 3, 1000, 0x30000, 5, 0x25001, 7 };
+    for (size_t size : sizes) {
+        std::vector<int64_t> expect(size);
+        for (auto& val : expect) {
+            val = prng0.get<int64_t>();
+        }
+        std::vector<int64_t> res(size);
+        prng1.fill(res.data(), size);
+        EXPECT_EQ(expect, res);
+
+        uint8_t byte = prng0.get<uint8_t>();
+        uint8_t byte_ = 0;
+        prng1.fill(&byte_, 1);
+        EXPECT_EQ(byte, byte_);
+    }
+}
+
+TEST(prng, buffer_size_test) {
+    block seed = _mm_set_epi64x(5, 6);
+
+    PseudorandomNumberGenerator prng0(seed);
+    PseudorandomNumberGenerator prng1(seed, 3);
+
+    EXPECT_EQ(3u, prng1.buffer_size());
+
+    // stream does not depend on buffer size
+    for (size_t i = 0; i < 100; ++i) {
+        EXPECT_EQ(prng0.get<uint64_t>(), prng1.get<uint64_t>());
+        EXPECT_EQ(prng0.get<uint8_t>(), prng1.get<uint8_t>());
+    }
+    std::vector<int64_t> res0(1000);
+    std::vector<int64_t> res1(1000);
+    prng0.fill(res0.data(), res0.size());
+    prng1.fill(res1.data(), res1.size());
+    EXPECT_EQ(res0, res1);
+
+    EXPECT_THROW(PseudorandomNumberGenerator(0), std::invalid_argument);
+}
+
+TEST(prng, unseeded_test) {
+    PseudorandomNumberGenerator prng;
+
+    uint64_t val = 0;
+    EXPECT_THROW(prng.get_array(&val, sizeof(val)), std::logic_error);
+    EXPECT_THROW(prng.get<uint8_t>(), std::logic_error);
+
+    PseudorandomNumberGenerator seeded(_mm_set_epi64x(7, 8));
+    prng.set_seed(_mm_set_epi64x(7, 8));
+    EXPECT_EQ(seeded.get<uint64_t>(), prng.get<uint64_t>());
+}
+
+TEST(prng, vec_op_test) {
+    const size_t num = 19;
+    std::vector<int64_t> lhs(num);
+    std::vector<int64_t> rhs(num);
+    std::vector<uint8_t> lhs8(num);
+    std::vector<uint8_t> rhs8(num);
+    for (size_t i = 0; i < num; ++i) {
+        lhs[i] = i * 0x123456789;
+        rhs[i] = -i * 0x987654321;
+        lhs8[i] = i * 37;
+        rhs8[i] = 200 + i;
+    }
+
+    std::vector<int64_t> res(num);
+    std::vector<uint8_t> res8(num);
+    vec_sub(lhs.data(), rhs.data(), res.data(), num);
+    vec_sub(lhs8.data(), rhs8.data(), res8.data(), num);
+    for (size_t i = 0; i < num; ++i) {
+        EXPECT_EQ((int64_t)(lhs[i] - rhs[i]), res[i]);
+        EXPECT_EQ((uint8_t)(lhs8[i] - rhs8[i]), res8[i]);
+    }
+
+    vec_xor(lhs.data(), rhs.data(), lhs.data(), num);
+    vec_xor(lhs8.data(), rhs8.data(), res8.data(), num);
+    for (size_t i = 0; i < num; ++i) {
+        EXPECT_EQ((int64_t)(i * 0x123456789) ^ rhs[i], lhs[i]);
+        EXPECT_EQ((uint8_t)((uint8_t)(i * 37) ^ rhs8[i]), res8[i]);
+    }
+}
+
+} // namespace common
@@ -16,6 +16,8 @@
 
 #include <array>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
 
 #include <emmintrin.h>
 
@@ -47,6 +49,65 @@ inline Block512 operator&(const Block512 &lhs, const Block512 &rhs) {
   return ret;
 }
 
+// lane-wise wrapping subtraction of 128-bit vectors by element type
+inline block sse_sub(const block &lhs, const block &rhs, int64_t) {
+  return _mm_sub_epi64(lhs, rhs);
+}
+
+inline block sse_sub(const block &lhs, const block &rhs, uint64_t) {
+  return _mm_sub_epi64(lhs, rhs);
+}
+
+inline block sse_sub(const block &lhs, const block &rhs, int32_t) {
+  return _mm_sub_epi32(lhs, rhs);
+}
+
+inline block sse_sub(const block &lhs, const block &rhs, uint32_t) {
+  return _mm_sub_epi32(lhs, rhs);
+}
+
+inline block sse_sub(const block &lhs, const block &rhs, int8_t) {
+  return _mm_sub_epi8(lhs, rhs);
+}
+
+inline block sse_sub(const block &lhs, const block &rhs, uint8_t) {
+  return _mm_sub_epi8(lhs, rhs);
+}
+
+// ret[i] = lhs[i] - rhs[i], ret may alias lhs or rhs
+template <typename T>
+inline void vec_sub(const T *lhs, const T *rhs, T *ret, size_t n) {
+  const size_t lanes = sizeof(block) / sizeof(T);
+  size_t i = 0;
+  for (; i + lanes <= n; i += lanes) {
+    block l = _mm_loadu_si128(reinterpret_cast<const block *>(lhs + i));
+    block r = _mm_loadu_si128(reinterpret_cast<const block *>(rhs + i));
+    _mm_storeu_si128(reinterpret_cast<block *>(ret + i), sse_sub(l, r, T()));
+  }
+  for (; i < n; ++i) {
+    ret[i] = lhs[i] - rhs[i];
+  }
+}
+
+// ret[i] = lhs[i] ^ rhs[i], ret may alias lhs or rhs
+template <typename T>
+inline void vec_xor(const T *lhs, const T *rhs, T *ret, size_t n) {
+  auto l = reinterpret_cast<const uint8_t *>(lhs);
+  auto r = reinterpret_cast<const uint8_t *>(rhs);
+  auto o = reinterpret_cast<uint8_t *>(ret);
+  const size_t len = n * sizeof(T);
+  size_t i = 0;
+  for (; i + sizeof(block) <= len; i += sizeof(block)) {
+    _mm_storeu_si128(
+        reinterpret_cast<block *>(o + i),
+        _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const block *>(l + i)),
+                      _mm_loadu_si128(reinterpret_cast<const block *>(r + i))));
+  }
+  for (; i < len; ++i) {
+    o[i] = l[i] ^ r[i];
+  }
+}
+
 // the maximum size of the stash for Cuckoo hashing.
 inline size_t get_stash_size(size_t input) {
 
@@ -24,6 +24,7 @@ limitations under the License. */
 #include "core/privc3/fixedpoint_util.h"
 #include "core/privc/fixedpoint_util.h"
 #include "core/paddlefl_mpc/mpc_protocol/aby3_operators.h"
+#include "core/paddlefl_mpc/mpc_protocol/comm_stats.h"
 #include "core/psi/psi_api.h"
 
 namespace py = pybind11;
@@ -118,6 +119,29 @@ std::vector<std::string> recv_psi(const std::string &remote_ip,
     return output;
 }
 
+// communication counters of each op, as
+// {op_type: {"rounds": n, "peers": {party: {counter: value}}}}
+py::dict comm_stats() {
+    py::dict ret;
+    for (auto& op : paddle::mpc::CommStats::snapshot()) {
+        py::dict peers;
+        for (auto& peer : op.second.peers) {
+            py::dict counters;
+            counters["bytes_sent"] = peer.second.bytes_sent;
+            counters["bytes_recv"] = peer.second.bytes_recv;
+            counters["msgs_sent"] = peer.second.msgs_sent;
+            counters["msgs_recv"] = peer.second.msgs_recv;
+            counters["recv_wait_us"] = peer.second.recv_wait_us;
+            peers[py::int_(peer.first)] = counters;
+        }
+        py::dict op_stats;
+        op_stats["rounds"] = op.second.rounds;
+        op_stats["peers"] = peers;
+        ret[py::str(op.first)] = op_stats;
+    }
+    return ret;
+}
+
 PYBIND11_MODULE(mpc_data_utils, m)
 {
     // optional module docstring
@@ -136,6 +160,10 @@ PYBIND11_MODULE(mpc_data_utils, m)
     m.def("send_psi", &send_psi, "Send input in two party PSI.");
     m.def("recv_psi", &recv_psi, "Send input and return PSI result as output in two party PSI.");
 
+    m.def("comm_stats", &comm_stats,
+          "return communication counters of each op, network should be initialized with enable_comm_stats.");
+    m.def("reset_comm_stats", &paddle::mpc::CommStats::reset, "clear communication counters.");
+
     int64_t ONE = 1;
     m.attr("mpc_one_share") = (ONE << paddle::mpc::ABY3_SCALING_FACTOR) / 3; // todo: remove
     m.attr("aby3_one_share") = (ONE << paddle::mpc::ABY3_SCALING_FACTOR) / 3;
@@ -18,6 +18,7 @@
 
 #include "core/paddlefl_mpc/mpc_protocol/abstract_network.h"
 #include "core/common/prng.h"
+#include "core/common/utils.h"
 #include "paddle/fluid/platform/enforce.h"
 
 namespace paddle {
@@ -76,18 +77,14 @@ public:
 
   template <typename T, template <typename> class Tensor>
   void gen_random(Tensor<T> &tensor, bool next) {
-    std::for_each(
-        tensor.data(), tensor.data() + tensor.numel(),
-        [this, next](T &val) { val = this->template gen_random<T>(next); });
+    get_prng(next).fill(tensor.data(), tensor.numel());
   }
 
   template <typename T> T gen_random_private() { return get_prng(2).get<T>(); }
 
   template <typename T, template <typename> class Tensor>
   void gen_random_private(Tensor<T> &tensor) {
-    std::for_each(
-        tensor.data(), tensor.data() + tensor.numel(),
-        [this](T &val) { val = this->template gen_random_private<T>(); });
+    get_prng(2).fill(tensor.data(), tensor.numel());
   }
 
   template <typename T> T gen_zero_sharing_arithmetic() {
@@ -96,10 +93,7 @@ public:
 
   template <typename T, template <typename> class Tensor>
   void gen_zero_sharing_arithmetic(Tensor<T> &tensor) {
-    std::for_each(tensor.data(), tensor.data() + tensor.numel(),
-                  [this](T &val) {
-                    val = this->template gen_zero_sharing_arithmetic<T>();
-                  });
+    gen_zero_sharing(tensor.data(), tensor.numel(), common::vec_sub<T>);
   }
 
   template <typename T> T gen_zero_sharing_boolean() {
@@ -108,14 +102,26 @@ public:
 
   template <typename T, template <typename> class Tensor>
   void gen_zero_sharing_boolean(Tensor<T> &tensor) {
-    std::for_each(
-        tensor.data(), tensor.data() + tensor.numel(),
-        [this](T &val) { val = this->template gen_zero_sharing_boolean<T>(); });
+    gen_zero_sharing(tensor.data(), tensor.numel(), common::vec_xor<T>);
   }
 
 protected:
   virtual PseudorandomNumberGenerator& get_prng(size_t idx) = 0;
 
+  // data = combine(prng[0] values, prng[1] values), the latter
+  // generated by chunks in a stack buffer
+  template <typename T, typename Combine>
+  void gen_zero_sharing(T *data, size_t numel, Combine combine) {
+    const size_t chunk = 0x1000 / sizeof(T);
+    T buffer[chunk];
+    get_prng(0).fill(data, numel);
+    for (size_t i = 0; i < numel; i += chunk) {
+      size_t num = std::min(chunk, numel - i);
+      get_prng(1).fill(buffer, num);
+      combine(data + i, buffer, data + i, num);
+    }
+  }
+
 private:
   size_t _num_party;
   size_t _party;
@@ -15,13 +15,85 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <future>
+#include <memory>
 #include <vector>
 
 #include "core/paddlefl_mpc/mpc_protocol/mpc_config.h"
+#include "paddle/fluid/platform/enforce.h"
 
 namespace paddle {
 namespace mpc {
 
+// completion handle of a non-blocking isend/irecv
+// buffer passed to isend/irecv must be kept alive and untouched
+// until wait() returns
+class AsyncHandle {
+public:
+  AsyncHandle() = default;
+
+  virtual ~AsyncHandle() = default;
+
+  AsyncHandle(const AsyncHandle &other) = delete;
+
+  AsyncHandle &operator=(const AsyncHandle &other) = delete;
+
+  // block until the transfer completes, may be called more than once
+  virtual void wait() = 0;
+};
+
+// handle for networks without native async support,
+// the blocking call is run in another thread
+class FutureHandle : public AsyncHandle {
+public:
+  explicit FutureHandle(std::future<void> future)
+      : _future(std::move(future)) {}
+
+  ~FutureHandle() {
+    if (_future.valid()) {
+      _future.wait();
+    }
+  }
+
+  void wait() override {
+    if (_future.valid()) {
+      _future.get();
+    }
+  }
+
+private:
+  std::future<void> _future;
+};
+
+// handle of a message sent in several transfers, owns their buffer
+class MultiHandle : public AsyncHandle {
+public:
+  MultiHandle(std::shared_ptr<std::vector<char>> buf,
+              std::vector<std::shared_ptr<AsyncHandle>> handles)
+      : _buf(std::move(buf)), _handles(std::move(handles)) {}
+
+  ~MultiHandle() {
+    try {
+      wait();
+    } catch (...) {
+      // buf must not be released while transfers may touch it
+    }
+  }
+
+  void wait() override {
+    for (auto &handle : _handles) {
+      handle->wait();
+    }
+  }
+
+private:
+  // declared first, so that it outlives the handles
+  std::shared_ptr<std::vector<char>> _buf;
+  std::vector<std::shared_ptr<AsyncHandle>> _handles;
+};
+
 class AbstractNetwork {
 public:
   AbstractNetwork() = default;
@@ -32,6 +104,80 @@ public:
 
   virtual void recv(size_t party, void *data, size_t size) = 0;
 
+  // non-blocking send, returns immediately
+  // implementations should override it if transport supports async io
+  virtual std::shared_ptr<AsyncHandle> isend(size_t party, const void *data,
+                                             size_t size) {
+    return std::make_shared<FutureHandle>(
+        std::async(std::launch::async, [this, party, data, size]() {
+          send(party, data, size);
+        }));
+  }
+
+  // non-blocking recv, returns immediately
+  virtual std::shared_ptr<AsyncHandle> irecv(size_t party, void *data,
+                                             size_t size) {
+    return std::make_shared<FutureHandle>(
+        std::async(std::launch::async, [this, party, data, size]() {
+          recv(party, data, size);
+        }));
+  }
+
+  // full-duplex exchange, send and recv are in flight at the same time
+  // so that a pairwise exchange costs one round
+  virtual void send_recv(size_t send_party, const void *send_data,
+                         size_t send_size, size_t recv_party,
+                         void *recv_data, size_t recv_size) {
+    auto send_handle = isend(send_party, send_data, send_size);
+    auto recv_handle = irecv(recv_party, recv_data, recv_size);
+    recv_handle->wait();
+    send_handle->wait();
+  }
+
+  // send a message whose size the receiver does not know, received by
+  // recv_any. by default it goes as a header of ANY_HEADER_SIZE bytes,
+  // holding the size and payload fitting in the rest, otherwise the
+  // payload follows as a second message. transports carrying sizes on
+  // wire should override both to send one message
+  virtual std::shared_ptr<AsyncHandle> isend_any(size_t party,
+                                                 const void *data,
+                                                 size_t size) {
+    auto header = std::make_shared<std::vector<char>>();
+    header->resize(ANY_HEADER_SIZE);
+    uint64_t size_ = size;
+    std::memcpy(header->data(), &size_, sizeof(uint64_t));
+    std::vector<std::shared_ptr<AsyncHandle>> handles;
+    if (size <= ANY_INLINE_SIZE) {
+      std::memcpy(header->data() + sizeof(uint64_t), data, size);
+      handles.emplace_back(isend(party, header->data(), header->size()));
+    } else {
+      handles.emplace_back(isend(party, header->data(), header->size()));
+      handles.emplace_back(isend(party, data, size));
+    }
+    return std::make_shared<MultiHandle>(std::move(header),
+                                         std::move(handles));
+  }
+
+  // recv a message sent by isend_any, payload is appended to data
+  virtual void recv_any(size_t party, std::vector<char> &data) {
+    char header[ANY_HEADER_SIZE];
+    recv(party, header, ANY_HEADER_SIZE);
+
+    uint64_t size = 0;
+    std::memcpy(&size, header, sizeof(uint64_t));
+    auto offset = data.size();
+    data.resize(offset + size);
+    if (size <= ANY_INLINE_SIZE) {
+      std::memcpy(data.data() + offset, header + sizeof(uint64_t), size);
+    } else {
+      recv(party, data.data() + offset, size);
+    }
+  }
+
+  static const size_t ANY_HEADER_SIZE = 256;
+
+  static const size_t ANY_INLINE_SIZE = ANY_HEADER_SIZE - sizeof(uint64_t);
+
   virtual void broadcast(const void *data, size_t size) {
     for (size_t i = 0; i < party_num(); ++i) {
       if (i == party_id()) {
@@ -71,6 +217,32 @@ public:
     return tensor;
   }
 
+  template <typename T, template <typename> class Tensor>
+  std::shared_ptr<AsyncHandle> isend(size_t party, const Tensor<T> &tensor) {
+    return isend(party, tensor.data(), sizeof(T) * tensor.numel());
+  }
+
+  template <typename T, template <typename> class Tensor>
+  std::shared_ptr<AsyncHandle> irecv(size_t party, Tensor<T> &tensor) {
+    return irecv(party, tensor.data(), sizeof(T) * tensor.numel());
+  }
+
+  template <typename T, template <typename> class Tensor>
+  Tensor<T> &send_recv(size_t send_party, const Tensor<T> &send_tensor,
+                       size_t recv_party, Tensor<T> &recv_tensor) {
+    send_recv(send_party, send_tensor.data(),
+              sizeof(T) * send_tensor.numel(), recv_party,
+              recv_tensor.data(), sizeof(T) * recv_tensor.numel());
+    return recv_tensor;
+  }
+
+  template <typename T> T send_recv(size_t send_party, const T &data,
+                                    size_t recv_party) {
+    T ret;
+    send_recv(send_party, &data, sizeof(T), recv_party, &ret, sizeof(T));
+    return ret;
+  }
+
   template <typename T> void broadcast(const T &data) {
     broadcast(&data, sizeof(T));
   }
@@ -110,6 +282,19 @@ public:
 
   virtual void init() = 0;
 
+  // send out data buffered by the network, if any.
+  // should be called before blocking other than on a recv
+  virtual void flush() {}
+
+  // create an initialized logical channel to the same parties, whose
+  // messages never interleave with those of this network or of other
+  // channels, so that channels can be used by different threads
+  // concurrently. all parties must create channel of the same id,
+  // which may block until they do. id 0 is this network itself.
+  virtual std::shared_ptr<AbstractNetwork> channel(size_t id) {
+    PADDLE_THROW("Channel is not supported by the network.");
+  }
+
 };
 
 } // namespace mpc
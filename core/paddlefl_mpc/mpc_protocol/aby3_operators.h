@@ -188,14 +188,16 @@ public:
         }
     }
 
-    void softmax(const Tensor *op, Tensor *out, bool use_relu, bool use_long_div) override {
+    void softmax(const Tensor *op, Tensor *out, bool use_relu, bool use_long_div,
+                 bool use_goldschmidt_div, bool use_split_exp) override {
         auto op_tuple = from_tensor(op);
         auto out_tuple = from_tensor(out);
 
         auto op_ = std::get<0>(op_tuple).get();
         auto out_ = std::get<0>(out_tuple).get();
 
-        op_->softmax(out_, use_relu, use_long_div);
+        op_->softmax(out_, use_relu, use_long_div,
+                     use_goldschmidt_div, use_split_exp);
     }
 
     void gt(const Tensor *lhs, const Tensor *rhs, Tensor *out) override {
@@ -352,7 +354,7 @@ public:
         auto y_tuple = from_tensor(out);
         auto y_ = std::get<0>(y_tuple).get();
 
-        x_->inverse_square_root(y_);
+        x_->inverse_square_root_normalized(y_);
     }
 
     // only support pred for 1 in binary classification for now
@@ -424,6 +426,40 @@ public:
                            return in / pow(2, ABY3_SCALING_FACTOR); });
     }
 
+    void reveal_many(const std::vector<const Tensor*>& ins,
+                     const std::vector<Tensor*>& outs) override {
+        PADDLE_ENFORCE_EQ(ins.size(), outs.size(),
+                          "Num of inputs and outputs should be equal.");
+        std::vector<Tensor> temp(ins.size());
+        // keep share tensors alive until revealed
+        std::vector<decltype(from_tensor(ins[0]))> in_tuples;
+        std::vector<std::shared_ptr<PaddleTensor>> out_tensors;
+        std::vector<const FixedTensor*> ins_;
+        std::vector<aby3::TensorAdapter<int64_t>*> outs_;
+
+        for (size_t i = 0; i < ins.size(); ++i) {
+            auto out_dims = framework::slice_ddim(ins[i]->dims(), 1, ins[i]->dims().size());
+            temp[i].mutable_data<int64_t>(out_dims, ContextHolder::device_ctx()->GetPlace());
+            outs[i]->mutable_data<double>(out_dims, ContextHolder::device_ctx()->GetPlace());
+
+            in_tuples.emplace_back(from_tensor(ins[i]));
+            ins_.emplace_back(std::get<0>(in_tuples.back()).get());
+
+            out_tensors.emplace_back(
+                std::make_shared<PaddleTensor>(ContextHolder::device_ctx(), temp[i]));
+            outs_.emplace_back(out_tensors.back().get());
+        }
+
+        FixedTensor::reveal_many(ins_, outs_);
+
+        for (size_t i = 0; i < ins.size(); ++i) {
+            std::transform(outs_[i]->data(), outs_[i]->data() + outs_[i]->numel(),
+                           outs[i]->data<double>(),
+                           [](int64_t in) {
+                               return in / pow(2, ABY3_SCALING_FACTOR); });
+        }
+    }
+
     void argmax(const Tensor *op, Tensor *out) override {
         PADDLE_THROW(platform::errors::Unimplemented(
             "argmax is not implemented."));
@@ -454,6 +490,8 @@ private:
             (sigmoid_func)(&FixedTensor::sigmoid_chebyshev)));
         sigmoid_func_map.insert(std::pair<std::string, sigmoid_func>("sigmoid_high_precision", 
             (sigmoid_func)(&FixedTensor::sigmoid_high_precision)));
+        sigmoid_func_map.insert(std::pair<std::string, sigmoid_func>("sigmoid_high_precision_split", 
+            (sigmoid_func)(&FixedTensor::sigmoid_high_precision_split)));
     }
 
     template <typename T>
@@ -68,6 +68,33 @@ std::shared_ptr<AbstractContext> Aby3Protocol::mpc_context() {
     return _circuit_ctx;
 }
 
+std::shared_ptr<AbstractContext> Aby3Protocol::channel_context(size_t channel) {
+    PADDLE_ENFORCE(_is_initialized, PROT_INIT_ERR);
+    if (channel == 0) {
+        return _circuit_ctx;
+    }
+
+    std::shared_ptr<Channel> ch;
+    {
+        std::lock_guard<std::mutex> lock(_channels_mutex);
+        auto& entry = _channels[channel];
+        if (!entry) {
+            entry = std::make_shared<Channel>();
+        }
+        ch = entry;
+    }
+
+    // create outside of _channels_mutex, for creating channel blocks
+    // until peers do, and threads of each party may come in any order
+    std::lock_guard<std::mutex> lock(ch->mutex);
+    if (!ch->ctx) {
+        // new prngs are synchronized by ctor of ABY3Context
+        ch->ctx = std::make_shared<ABY3Context>(_circuit_ctx->party(),
+                                                _network->channel(channel));
+    }
+    return ch->ctx;
+}
+
 void Aby3Protocol::init(MpcConfig &config) {
     if (_is_initialized) {
         return;
@@ -87,7 +114,14 @@ void Aby3Protocol::init(MpcConfig &config) {
 
     mesh_net->init();
     _network = std::move(mesh_net);
-    _circuit_ctx = std::make_shared<ABY3Context>(role, _network);
+    auto ctx = std::make_shared<ABY3Context>(role, _network);
+
+    auto preprocessing_file = config.get(MpcConfig::PREPROCESSING_FILE);
+    if (!preprocessing_file.empty()) {
+        ctx->store().load(preprocessing_file + "." + std::to_string(role));
+    }
+    _circuit_ctx = std::move(ctx);
+
     _operators = std::make_shared<Aby3OperatorsImpl>();
     _is_initialized = true;
 
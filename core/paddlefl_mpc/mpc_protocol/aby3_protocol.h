@@ -18,6 +18,9 @@
 
 #pragma once
 
+#include <mutex>
+#include <unordered_map>
+
 #include "abstract_network.h"
 #include "aby3_operators.h"
 #include "gloo/rendezvous/hash_store.h"
@@ -48,7 +51,13 @@ public:
 
   std::shared_ptr<AbstractContext> mpc_context() override;
 
+  std::shared_ptr<AbstractContext> channel_context(size_t channel) override;
+
 private:
+  struct Channel {
+    std::mutex mutex;
+    std::shared_ptr<AbstractContext> ctx;
+  };
 
   bool _is_initialized = false;
   const size_t net_size = 3;
@@ -56,6 +65,9 @@ private:
   std::shared_ptr<MpcOperators> _operators;
   std::shared_ptr<AbstractNetwork> _network;
   std::shared_ptr<AbstractContext> _circuit_ctx;
+
+  std::mutex _channels_mutex;
+  std::unordered_map<size_t, std::shared_ptr<Channel>> _channels;
 };
 
 } // mpc
@@ -0,0 +1,67 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "comm_stats.h"
+
+namespace paddle {
+namespace mpc {
+
+const std::string CommStats::UNATTRIBUTED("unattributed");
+
+std::mutex CommStats::_mutex;
+CommStats::StatsMap CommStats::_stats;
+
+OpCommStats &CommStats::op_stats(const std::string &op_type) {
+  return _stats[op_type.empty() ? UNATTRIBUTED : op_type];
+}
+
+void CommStats::record_send(const std::string &op_type, size_t peer,
+                            size_t bytes) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  auto &stats = op_stats(op_type).peers[peer];
+  stats.bytes_sent += bytes;
+  ++stats.msgs_sent;
+}
+
+void CommStats::record_recv(const std::string &op_type, size_t peer,
+                            size_t bytes) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  auto &stats = op_stats(op_type).peers[peer];
+  stats.bytes_recv += bytes;
+  ++stats.msgs_recv;
+}
+
+void CommStats::record_recv_wait(const std::string &op_type, size_t peer,
+                                 uint64_t wait_us) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  op_stats(op_type).peers[peer].recv_wait_us += wait_us;
+}
+
+void CommStats::record_round(const std::string &op_type) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  ++op_stats(op_type).rounds;
+}
+
+CommStats::StatsMap CommStats::snapshot() {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _stats;
+}
+
+void CommStats::reset() {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _stats.clear();
+}
+
+} // mpc
+} // paddle
@@ -0,0 +1,77 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Description:
+// process-wide communication counters, keyed by op type and peer party
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace paddle {
+namespace mpc {
+
+struct PeerCommStats {
+  uint64_t bytes_sent = 0;
+  uint64_t bytes_recv = 0;
+  uint64_t msgs_sent = 0;
+  uint64_t msgs_recv = 0;
+  // time blocked in waiting for recv, in microseconds
+  uint64_t recv_wait_us = 0;
+};
+
+struct OpCommStats {
+  // a round is a run of recvs that follows a send,
+  // i.e. the num of times the op has to wait for its peers
+  uint64_t rounds = 0;
+  std::map<size_t, PeerCommStats> peers;
+};
+
+class CommStats {
+public:
+  using StatsMap = std::map<std::string, OpCommStats>;
+
+  CommStats() = delete;
+
+  static void record_send(const std::string &op_type, size_t peer,
+                          size_t bytes);
+
+  static void record_recv(const std::string &op_type, size_t peer,
+                          size_t bytes);
+
+  static void record_recv_wait(const std::string &op_type, size_t peer,
+                               uint64_t wait_us);
+
+  static void record_round(const std::string &op_type);
+
+  // copy of all counters
+  static StatsMap snapshot();
+
+  static void reset();
+
+  // key of traffic outside any op
+  static const std::string UNATTRIBUTED;
+
+private:
+  static OpCommStats &op_stats(const std::string &op_type);
+
+  static std::mutex _mutex;
+  static StatsMap _stats;
+};
+
+} // mpc
+} // paddle
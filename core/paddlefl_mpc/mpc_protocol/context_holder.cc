@@ -28,6 +28,8 @@ thread_local std::shared_ptr<AbstractContext> ContextHolder::current_mpc_ctx;
 
 thread_local const ExecutionContext *ContextHolder::current_exec_ctx;
 
+thread_local std::string ContextHolder::current_op_type;
+
 thread_local std::shared_ptr<common::TensorAdapterFactory>
     ContextHolder::_s_current_tensor_factory;
 
@@ -21,6 +21,8 @@
 
 #pragma once
 
+#include <string>
+
 #include "paddle/fluid/framework/operator.h"
 #include "core/privc3/aby3_context.h"
 #include "core/common/paddle_tensor.h"
@@ -37,6 +39,16 @@ public:
   static void run_with_context(const ExecutionContext *exec_ctx,
                                std::shared_ptr<AbstractContext> mpc_ctx,
                                Operation op) {
+    run_with_context(exec_ctx, mpc_ctx, std::string(), op);
+  }
+
+  // op_type: type of the op being run, network traffic in op() is
+  // attributed to it. an empty op_type keeps that of enclosing context
+  template <typename Operation>
+  static void run_with_context(const ExecutionContext *exec_ctx,
+                               std::shared_ptr<AbstractContext> mpc_ctx,
+                               const std::string &op_type,
+                               Operation op) {
 
     // set new ctxs
     auto old_mpc_ctx = current_mpc_ctx;
@@ -45,6 +57,13 @@ public:
     auto old_exec_ctx = current_exec_ctx;
     current_exec_ctx = exec_ctx;
 
+    auto old_op_type = current_op_type;
+    if (!op_type.empty()) {
+      current_op_type = op_type;
+    }
+
+    // each op has its own pool of temporaries, released in bulk
+    // as the factory is restored after op
     auto old_factory = _s_current_tensor_factory;
 
     _s_current_tensor_factory = nullptr;
@@ -54,9 +73,15 @@ public:
     // run the op
     op();
 
+    // send out msgs coalesced in op
+    if (mpc_ctx) {
+      mpc_ctx->network()->flush();
+    }
+
     // restore ctxs
     current_mpc_ctx = old_mpc_ctx;
     current_exec_ctx = old_exec_ctx;
+    current_op_type = old_op_type;
     _s_current_tensor_factory = old_factory;
   }
 
@@ -64,6 +89,8 @@ public:
 
   static const ExecutionContext *exec_ctx() { return current_exec_ctx; }
 
+  static const std::string &op_type() { return current_op_type; }
+
   static const paddle::platform::DeviceContext *device_ctx() {
     return &current_exec_ctx->device_context();
   }
@@ -71,7 +98,7 @@ public:
   static std::shared_ptr<common::TensorAdapterFactory> tensor_factory() {
     if (!_s_current_tensor_factory) {
       _s_current_tensor_factory =
-          std::make_shared<common::PaddleTensorFactory>(device_ctx());
+          std::make_shared<common::PooledPaddleTensorFactory>(device_ctx());
     }
     return _s_current_tensor_factory;
   }
@@ -81,6 +108,8 @@ private:
 
   thread_local static const ExecutionContext *current_exec_ctx;
 
+  thread_local static std::string current_op_type;
+
   thread_local static std::shared_ptr<common::TensorAdapterFactory>
       _s_current_tensor_factory;
 };
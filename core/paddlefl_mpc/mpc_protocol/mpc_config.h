@@ -69,6 +69,20 @@ public:
   static const std::string NET_SERVER_PORT;
   static const std::string ENDPOINTS;
   static const std::string NETWORK_MODE;
+  static const std::string NET_QUEUE_DEPTH;
+  static const std::string NET_SHM_NAME;
+  static const std::string NET_METERED;
+  static const std::string NET_COALESCE;
+  // wan emulation, enabled if any of latency, bandwidth or links is set
+  static const std::string NET_WAN_LATENCY_US;
+  static const std::string NET_WAN_BANDWIDTH_MBPS;
+  static const std::string NET_WAN_JITTER_US;
+  static const std::string NET_WAN_LINKS;
+  static const std::string NET_WAN_SEED;
+  static const std::string NET_WAN_COUNT_COMPUTE;
+  // randomness preprocessed by CorrelatedRandomnessStore::save,
+  // file of party i is "<value>.i", loaded once and removed
+  static const std::string PREPROCESSING_FILE;
 
   // default values
   static const std::string LOCAL_ADDR_DEFAULT;
@@ -76,6 +90,8 @@ public:
   static const int NET_SERVER_PORT_DEFAULT;
   static const std::string ENDPOINTS_DEFAULT;
   static const std::string NETWORK_MODE_DEFAULT;
+  static const int NET_QUEUE_DEPTH_DEFAULT;
+  static const std::string NET_SHM_NAME_DEFAULT;
 };
 
 } // mpc
@@ -27,13 +27,27 @@ const std::string MpcConfig::NET_SERVER_ADDR("net_server.address");
 const std::string MpcConfig::NET_SERVER_PORT("net_server.port");
 const std::string MpcConfig::ENDPOINTS("endpoints");
 const std::string MpcConfig::NETWORK_MODE("network_mode");
+const std::string MpcConfig::NET_QUEUE_DEPTH("net.queue_depth");
+const std::string MpcConfig::NET_SHM_NAME("net.shm_name");
+const std::string MpcConfig::NET_METERED("net.metered");
+const std::string MpcConfig::NET_COALESCE("net.coalesce");
+const std::string MpcConfig::NET_WAN_LATENCY_US("net.wan.latency_us");
+const std::string MpcConfig::NET_WAN_BANDWIDTH_MBPS("net.wan.bandwidth_mbps");
+const std::string MpcConfig::NET_WAN_JITTER_US("net.wan.jitter_us");
+const std::string MpcConfig::NET_WAN_LINKS("net.wan.links");
+const std::string MpcConfig::NET_WAN_SEED("net.wan.seed");
+const std::string MpcConfig::NET_WAN_COUNT_COMPUTE("net.wan.count_compute");
+const std::string MpcConfig::PREPROCESSING_FILE("preprocessing.file");
 
 const std::string MpcConfig::LOCAL_ADDR_DEFAULT("localhost");
 const std::string MpcConfig::NET_SERVER_ADDR_DEFAULT("localhost");
 const std::string MpcConfig::ENDPOINTS_DEFAULT("localhost:8900;localhost:8901;localhost:8902");
 const std::string MpcConfig::NETWORK_MODE_DEFAULT("grpc");
+const std::string MpcConfig::NET_SHM_NAME_DEFAULT("/paddle-mpc-shm");
 const int MpcConfig::NET_SERVER_PORT_DEFAULT =
     6379; // default redis server port
+const int MpcConfig::NET_QUEUE_DEPTH_DEFAULT =
+    64; // num of messages buffered for each peer
 
 } // mpc
 } // paddle
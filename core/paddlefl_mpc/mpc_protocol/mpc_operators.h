@@ -103,11 +103,14 @@ public:
                                       Tensor *derivative) = 0;
 
     /* sigmoid function.
-     * mode: sigmoid(piece_wise_3), sigmoid_enhanced(piece_wise_5), sigmoid_chebyshev, sigmoid_high_precision(exp)
+     * mode: sigmoid(piece_wise_3), sigmoid_enhanced(piece_wise_5), sigmoid_chebyshev, sigmoid_high_precision(exp),
+     *       sigmoid_high_precision_split(exp by bit decomposition)
      */ 
     virtual void sigmoid(const Tensor *op, Tensor *out, const std::string mode = "sigmoid") = 0;
 
-    virtual void softmax(const Tensor *op, Tensor *out, bool use_relu, bool use_long_div) = 0;
+    virtual void softmax(const Tensor *op, Tensor *out, bool use_relu, bool use_long_div,
+                         bool use_goldschmidt_div = false,
+                         bool use_split_exp = false) = 0;
 
     virtual void gt(const Tensor *lhs, const Tensor *rhs, Tensor *out) = 0;
 
@@ -160,6 +163,14 @@ public:
     // std::cout << tensor_to_print;
     virtual void reveal(const Tensor *in, Tensor* out) {};
 
+    // reveal tensors in one round
+    virtual void reveal_many(const std::vector<const Tensor*>& ins,
+                             const std::vector<Tensor*>& outs) {
+        for (size_t i = 0; i < ins.size(); ++i) {
+            reveal(ins[i], outs[i]);
+        }
+    }
+
     // convert TensorAdapter to shares and distribute to all parties
     // party: the party who has original data.
     virtual void online_share(size_t party, const Tensor *input, Tensor *out) = 0;
@@ -46,6 +46,14 @@ public:
 
   virtual std::shared_ptr<AbstractContext> mpc_context() = 0;
 
+  // context on network channel, see AbstractNetwork::channel.
+  // ops on different channels can be run concurrently.
+  // channel 0 is mpc_context()
+  virtual std::shared_ptr<AbstractContext> channel_context(size_t channel) {
+    PADDLE_ENFORCE_EQ(channel, 0UL, "Protocol %s has no channels.", _name);
+    return mpc_context();
+  }
+
 private:
   const std::string _name;
 };
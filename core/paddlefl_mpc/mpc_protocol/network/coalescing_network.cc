@@ -0,0 +1,146 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "coalescing_network.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "paddle/fluid/platform/enforce.h"
+
+namespace paddle {
+namespace mpc {
+
+const size_t CoalescingNetwork::MAX_BUFFER_SIZE_DEFAULT;
+
+void CoalescingRecvHandle::wait() { _net->wait_recv(_party, _seq); }
+
+CoalescingNetwork::CoalescingNetwork(std::shared_ptr<AbstractNetwork> network,
+                                     size_t max_buffer_size)
+    : _network(std::move(network)), _max_buffer_size(max_buffer_size),
+      _peers(_network->party_num()) {}
+
+CoalescingNetwork::~CoalescingNetwork() {
+  try {
+    flush();
+  } catch (...) {
+    // peer may be gone
+  }
+}
+
+void CoalescingNetwork::enforce_party(size_t party) {
+  PADDLE_ENFORCE_LT(party, party_num(), "Input role should be less than net_size.");
+  PADDLE_ENFORCE_NE(party, party_id(), "Party should not send data to itself.");
+}
+
+void CoalescingNetwork::send(size_t party, const void *data, size_t size) {
+  isend(party, data, size);
+}
+
+void CoalescingNetwork::recv(size_t party, void *data, size_t size) {
+  irecv(party, data, size)->wait();
+}
+
+std::shared_ptr<AsyncHandle> CoalescingNetwork::isend(size_t party,
+                                                      const void *data,
+                                                      size_t size) {
+  enforce_party(party);
+  auto &out = _peers[party].out;
+  auto begin = reinterpret_cast<const char *>(data);
+  out.insert(out.end(), begin, begin + size);
+  if (out.size() > _max_buffer_size) {
+    flush_peer(party);
+  }
+  return std::make_shared<CoalescingSendHandle>();
+}
+
+std::shared_ptr<AsyncHandle> CoalescingNetwork::irecv(size_t party, void *data,
+                                                      size_t size) {
+  enforce_party(party);
+  auto &peer = _peers[party];
+  peer.recvs.push_back({data, size});
+  return std::make_shared<CoalescingRecvHandle>(this, party,
+                                                peer.recv_issued++);
+}
+
+void CoalescingNetwork::flush_peer(size_t party) {
+  auto &out = _peers[party].out;
+  if (out.empty()) {
+    return;
+  }
+
+  auto frame = std::make_shared<std::vector<char>>();
+  frame->swap(out);
+  _inflight_handles.emplace_back(
+      _network->isend_any(party, frame->data(), frame->size()));
+  _inflight_bufs.emplace_back(std::move(frame));
+}
+
+void CoalescingNetwork::wait_sends() {
+  for (auto &handle : _inflight_handles) {
+    handle->wait();
+  }
+  _inflight_handles.clear();
+  _inflight_bufs.clear();
+}
+
+void CoalescingNetwork::flush() {
+  for (size_t i = 0; i < _peers.size(); ++i) {
+    flush_peer(i);
+  }
+  wait_sends();
+  _network->flush();
+}
+
+void CoalescingNetwork::recv_frame(size_t party) {
+  auto &peer = _peers[party];
+  auto &in = peer.in;
+  // drop consumed data
+  in.erase(in.begin(), in.begin() + peer.in_pos);
+  peer.in_pos = 0;
+
+  _network->recv_any(party, in);
+}
+
+void CoalescingNetwork::wait_recv(size_t party, uint64_t seq) {
+  auto &peer = _peers[party];
+  if (seq < peer.recv_done) {
+    return;
+  }
+
+  // about to block, peers may be waiting for buffered data
+  for (size_t i = 0; i < _peers.size(); ++i) {
+    flush_peer(i);
+  }
+
+  while (peer.recv_done <= seq) {
+    auto &req = peer.recvs.front();
+    while (peer.in.size() - peer.in_pos < req.size) {
+      recv_frame(party);
+    }
+    std::memcpy(req.data, peer.in.data() + peer.in_pos, req.size);
+    peer.in_pos += req.size;
+    if (peer.in_pos == peer.in.size()) {
+      peer.in.clear();
+      peer.in_pos = 0;
+    }
+    peer.recvs.pop_front();
+    ++peer.recv_done;
+  }
+
+  wait_sends();
+}
+
+} // mpc
+} // paddle
@@ -0,0 +1,133 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "core/paddlefl_mpc/mpc_protocol/abstract_network.h"
+
+namespace paddle {
+namespace mpc {
+
+class CoalescingNetwork;
+
+// sent data is copied into buffer on isend, nothing to wait
+class CoalescingSendHandle : public AsyncHandle {
+public:
+  void wait() override {}
+};
+
+// recvs of a peer are served in order of issue,
+// waiting on a handle serves all earlier recvs of the peer
+class CoalescingRecvHandle : public AsyncHandle {
+public:
+  CoalescingRecvHandle(CoalescingNetwork *net, size_t party, uint64_t seq)
+      : _net(net), _party(party), _seq(seq) {}
+
+  void wait() override;
+
+private:
+  CoalescingNetwork *_net;
+  const size_t _party;
+  const uint64_t _seq;
+};
+
+// A write-combining wrapper of the underlying network. sends to a peer
+// are buffered and go out as one frame when this party is about to
+// block on a recv, or on flush(). received frames are split back into
+// messages by the sizes of the recvs, so protocols are unaware of it.
+//
+// frame: buffered data sent by isend_any of the underlying network,
+// one message on transports carrying sizes on wire.
+class CoalescingNetwork : public paddle::mpc::AbstractNetwork {
+public:
+  // max_buffer_size: buffered data of a peer larger than it is
+  // flushed without waiting for a recv
+  explicit CoalescingNetwork(std::shared_ptr<AbstractNetwork> network,
+                             size_t max_buffer_size = MAX_BUFFER_SIZE_DEFAULT);
+
+  virtual ~CoalescingNetwork();
+
+  void send(size_t party, const void *data, size_t size) override;
+
+  void recv(size_t party, void *data, size_t size) override;
+
+  std::shared_ptr<AsyncHandle> isend(size_t party, const void *data,
+                                     size_t size) override;
+
+  std::shared_ptr<AsyncHandle> irecv(size_t party, void *data,
+                                     size_t size) override;
+
+  size_t party_id() const override { return _network->party_id(); };
+
+  size_t party_num() const override { return _network->party_num(); };
+
+  void init() override { _network->init(); }
+
+  // send out buffered data of all peers and wait for completion
+  void flush() override;
+
+  std::shared_ptr<AbstractNetwork> channel(size_t id) override {
+    return std::make_shared<CoalescingNetwork>(_network->channel(id),
+                                               _max_buffer_size);
+  }
+
+  // called by CoalescingRecvHandle
+  void wait_recv(size_t party, uint64_t seq);
+
+  static const size_t MAX_BUFFER_SIZE_DEFAULT = 1 << 20;
+
+private:
+  struct PendingRecv {
+    void *data;
+    size_t size;
+  };
+
+  struct Peer {
+    // data to be sent
+    std::vector<char> out;
+    // data received but not yet consumed by recvs
+    std::vector<char> in;
+    size_t in_pos = 0;
+    std::deque<PendingRecv> recvs;
+    uint64_t recv_issued = 0;
+    uint64_t recv_done = 0;
+  };
+
+  // send out buffered data of party without waiting
+  void flush_peer(size_t party);
+
+  // recv a frame from party and append it to input of party
+  void recv_frame(size_t party);
+
+  // wait for frames in flight
+  void wait_sends();
+
+  void enforce_party(size_t party);
+
+  std::shared_ptr<AbstractNetwork> _network;
+  const size_t _max_buffer_size;
+  std::vector<Peer> _peers;
+
+  // buffers of frames in flight and their handles
+  std::vector<std::shared_ptr<std::vector<char>>> _inflight_bufs;
+  std::vector<std::shared_ptr<AsyncHandle>> _inflight_handles;
+};
+
+} // mpc
+} // paddle
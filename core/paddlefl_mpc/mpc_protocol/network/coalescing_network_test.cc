@@ -0,0 +1,164 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "core/paddlefl_mpc/mpc_protocol/network/coalescing_network.h"
+
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "core/paddlefl_mpc/mpc_protocol/comm_stats.h"
+#include "core/paddlefl_mpc/mpc_protocol/network/mesh_network_shm.h"
+#include "core/paddlefl_mpc/mpc_protocol/network/metered_network.h"
+#include "core/paddlefl_mpc/mpc_protocol/network/wan_network.h"
+
+namespace paddle {
+namespace mpc {
+
+class CoalescingNetworkTest : public ::testing::Test {
+public:
+  std::shared_ptr<AbstractNetwork> _p0;
+  std::shared_ptr<AbstractNetwork> _p1;
+
+  void SetUp() {
+    // metered underlying network counts frames on the wire
+    _p0 = std::make_shared<CoalescingNetwork>(
+        std::make_shared<MeteredNetwork>(
+            std::make_shared<MeshNetworkShm>(0, 2, "test_coalescing")),
+        1024);
+    _p1 = std::make_shared<CoalescingNetwork>(
+        std::make_shared<MeteredNetwork>(
+            std::make_shared<MeshNetworkShm>(1, 2, "test_coalescing")),
+        1024);
+
+    std::thread t0([this]() { _p0->init(); });
+    std::thread t1([this]() { _p1->init(); });
+    t0.join();
+    t1.join();
+
+    CommStats::reset();
+  }
+};
+
+TEST_F(CoalescingNetworkTest, coalesce_test) {
+  int buf[3] = {0};
+  std::thread t0([this]() {
+    _p0->template send(1, 1);
+    _p0->template send(1, 2);
+    _p0->template send(1, 3);
+    // sends go out as one frame before blocking
+    _p0->template recv<int>(1);
+  });
+
+  std::thread t1([this, &buf]() {
+    _p1->recv(0, buf, sizeof(buf));
+    _p1->template send(0, 0);
+    _p1->flush();
+  });
+  t0.join();
+  t1.join();
+
+  EXPECT_EQ(1, buf[0]);
+  EXPECT_EQ(2, buf[1]);
+  EXPECT_EQ(3, buf[2]);
+
+  auto stats = CommStats::snapshot()[CommStats::UNATTRIBUTED];
+  EXPECT_EQ(1u, stats.peers[1].msgs_sent);
+  EXPECT_EQ(1u, stats.peers[0].msgs_sent);
+}
+
+TEST_F(CoalescingNetworkTest, large_send_recv_test) {
+  // larger than inline data and max buffer size
+  std::vector<int64_t> in0(1000);
+  std::vector<int64_t> in1(100);
+  for (size_t i = 0; i < in0.size(); ++i) {
+    in0[i] = i;
+  }
+  for (size_t i = 0; i < in1.size(); ++i) {
+    in1[i] = -i;
+  }
+  std::vector<int64_t> out0(in1.size());
+  std::vector<int64_t> out1(in0.size());
+
+  std::thread t0([&]() {
+    _p0->send_recv(1, in0.data(), in0.size() * sizeof(int64_t),
+                   1, out0.data(), out0.size() * sizeof(int64_t));
+  });
+  std::thread t1([&]() {
+    // recvs are served in order of issue, whatever order of waits
+    auto h0 = _p1->irecv(0, out1.data(), 10 * sizeof(int64_t));
+    auto h1 = _p1->irecv(0, out1.data() + 10, (out1.size() - 10) * sizeof(int64_t));
+    _p1->send(0, in1.data(), in1.size() * sizeof(int64_t));
+    h1->wait();
+    h0->wait();
+  });
+  t0.join();
+  t1.join();
+
+  EXPECT_EQ(in1, out0);
+  EXPECT_EQ(in0, out1);
+
+  // sizes are on wire of shm, a large frame is one message
+  auto stats = CommStats::snapshot()[CommStats::UNATTRIBUTED];
+  EXPECT_EQ(1u, stats.peers[1].msgs_sent);
+  EXPECT_EQ(1u, stats.peers[0].msgs_sent);
+}
+
+TEST(CoalescingNetwork, default_frame_test) {
+  // wan network frames by default header of AbstractNetwork
+  std::vector<WanLink> links(4);
+  auto p0 = std::make_shared<CoalescingNetwork>(
+      std::make_shared<WanNetwork>(
+          std::make_shared<MeshNetworkShm>(0, 2, "test_coalescing_wan"),
+          links),
+      1024);
+  auto p1 = std::make_shared<CoalescingNetwork>(
+      std::make_shared<WanNetwork>(
+          std::make_shared<MeshNetworkShm>(1, 2, "test_coalescing_wan"),
+          links),
+      1024);
+  std::thread t0([&]() { p0->init(); });
+  std::thread t1([&]() { p1->init(); });
+  t0.join();
+  t1.join();
+
+  // inline and following payload
+  std::vector<int64_t> in0 = {1, 2, 3};
+  std::vector<int64_t> in1(1000);
+  for (size_t i = 0; i < in1.size(); ++i) {
+    in1[i] = i;
+  }
+  std::vector<int64_t> out0(in0.size());
+  std::vector<int64_t> out1(in1.size());
+
+  t0 = std::thread([&]() {
+    p0->send(1, in0.data(), in0.size() * sizeof(int64_t));
+    p0->flush();
+    p0->send(1, in1.data(), in1.size() * sizeof(int64_t));
+    p0->flush();
+  });
+  t1 = std::thread([&]() {
+    p1->recv(0, out0.data(), out0.size() * sizeof(int64_t));
+    p1->recv(0, out1.data(), out1.size() * sizeof(int64_t));
+  });
+  t0.join();
+  t1.join();
+
+  EXPECT_EQ(in0, out0);
+  EXPECT_EQ(in1, out1);
+}
+
+} // namespace mpc
+} // namespace paddle
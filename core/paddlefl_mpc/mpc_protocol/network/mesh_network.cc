@@ -41,22 +41,41 @@ void MeshNetwork::init() {
 }
 
 void MeshNetwork::send(size_t party, const void *data, size_t size) {
+  isend(party, data, size)->wait();
+}
+
+void MeshNetwork::recv(size_t party, void *data, size_t size) {
+  irecv(party, data, size)->wait();
+}
+
+std::shared_ptr<AsyncHandle> MeshNetwork::isend(size_t party,
+                                                const void *data,
+                                                size_t size) {
   PADDLE_ENFORCE_NOT_NULL(data);
   PADDLE_ENFORCE(_is_initialized);
 
   auto unbounded_buf =
       _rendezvous_ctx->createUnboundBuffer(const_cast<void *>(data), size);
-  unbounded_buf->send(party, 0UL /*slot*/);
-  unbounded_buf->waitSend();
+  unbounded_buf->send(party, _slot);
+  return std::make_shared<GlooHandle>(std::move(unbounded_buf), true);
 }
 
-void MeshNetwork::recv(size_t party, void *data, size_t size) {
+std::shared_ptr<AsyncHandle> MeshNetwork::irecv(size_t party, void *data,
+                                                size_t size) {
   PADDLE_ENFORCE_NOT_NULL(data);
   PADDLE_ENFORCE(_is_initialized);
 
   auto unbounded_buf = _rendezvous_ctx->createUnboundBuffer(data, size);
-  unbounded_buf->recv(party, 0UL /*slot*/);
-  unbounded_buf->waitRecv();
+  unbounded_buf->recv(party, _slot);
+  return std::make_shared<GlooHandle>(std::move(unbounded_buf), false);
+}
+
+std::shared_ptr<AbstractNetwork> MeshNetwork::channel(size_t id) {
+  PADDLE_ENFORCE(_is_initialized);
+  PADDLE_ENFORCE_EQ(_slot, 0UL, "Channel of a channel is not supported.");
+  PADDLE_ENFORCE_GT(id, 0, "Channel 0 is the network itself.");
+
+  return std::shared_ptr<MeshNetwork>(new MeshNetwork(*this, id));
 }
 
 } // mpc
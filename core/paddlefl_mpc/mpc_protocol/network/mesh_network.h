@@ -16,6 +16,7 @@
 #include <string>
 
 #include "gloo/rendezvous/context.h"
+#include "gloo/transport/unbound_buffer.h"
 #include "gloo/rendezvous/hash_store.h"
 #include "gloo/rendezvous/redis_store.h"
 
@@ -25,6 +26,39 @@
 namespace paddle {
 namespace mpc {
 
+// completion handle of a gloo unbound buffer
+class GlooHandle : public AsyncHandle {
+public:
+  GlooHandle(std::unique_ptr<gloo::transport::UnboundBuffer> buf,
+             bool is_send)
+      : _buf(std::move(buf)), _is_send(is_send), _is_done(false) {}
+
+  ~GlooHandle() {
+    try {
+      wait();
+    } catch (...) {
+      // buffer must not be released with pending io
+    }
+  }
+
+  void wait() override {
+    if (_is_done) {
+      return;
+    }
+    _is_done = true;
+    if (_is_send) {
+      _buf->waitSend();
+    } else {
+      _buf->waitRecv();
+    }
+  }
+
+private:
+  std::unique_ptr<gloo::transport::UnboundBuffer> _buf;
+  const bool _is_send;
+  bool _is_done;
+};
+
 // A full-connected network based on underlying GLOO toolkit.
 class MeshNetwork : public paddle::mpc::AbstractNetwork {
 public:
@@ -42,7 +76,7 @@ public:
               std::shared_ptr<gloo::rendezvous::Store> store)
       : _party_id(party_id), _local_addr(local_addr), _net_size(net_size),
         _store_prefix(prefix), _store(std::move(store)),
-        _is_initialized(false) {}
+        _slot(0), _is_initialized(false) {}
 
   virtual ~MeshNetwork() = default;
 
@@ -50,6 +84,12 @@ public:
 
   void recv(size_t party, void *data, size_t size) override;
 
+  std::shared_ptr<AsyncHandle> isend(size_t party, const void *data,
+                                     size_t size) override;
+
+  std::shared_ptr<AsyncHandle> irecv(size_t party, void *data,
+                                     size_t size) override;
+
   size_t party_id() const override { return _party_id; };
 
   size_t party_num() const override { return _net_size; };
@@ -57,7 +97,17 @@ public:
   // must be called before use
   void init();
 
+  // a channel shares the gloo context, and uses slot id
+  std::shared_ptr<AbstractNetwork> channel(size_t id) override;
+
 private:
+  // channel on slot of an initialized network
+  MeshNetwork(const MeshNetwork &other, uint64_t slot)
+      : _party_id(other._party_id), _net_size(other._net_size),
+        _local_addr(other._local_addr), _store_prefix(other._store_prefix),
+        _store(other._store), _rendezvous_ctx(other._rendezvous_ctx),
+        _slot(slot), _is_initialized(true) {}
+
   const size_t _party_id;
   const size_t _net_size;
   const std::string _local_addr;
@@ -66,6 +116,8 @@ private:
   const std::shared_ptr<gloo::rendezvous::Store> _store;
   std::shared_ptr<gloo::rendezvous::Context> _rendezvous_ctx;
 
+  const uint64_t _slot;
+
   bool _is_initialized;
 };
 
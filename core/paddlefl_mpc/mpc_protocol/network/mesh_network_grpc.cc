@@ -19,28 +19,24 @@
 namespace paddle {
 namespace mpc {
 
-void GrpcBuffer::write_buffer(const size_t party_id, const std::string data) {
-    std::unique_lock<std::mutex> lck(mtx);
-    while (buffer[party_id].size() == BUFFER_LENGTH) {
-        write_cv.wait(lck);
+GrpcBuffer::GrpcBuffer(size_t net_size, size_t depth) {
+    for (size_t i = 0; i < net_size; ++i) {
+        _queues.emplace_back(new SpscQueue<std::string>(depth));
     }
+}
 
-    buffer[party_id].push(data);
-    if (buffer[party_id].size() == BUFFER_LENGTH) {
-        read_cv.notify_all();
-    }
+bool GrpcBuffer::write_buffer(const size_t party_id, std::string&& data) {
+    return _queues[party_id]->push(std::move(data));
 }
 
 void GrpcBuffer::read_buffer(const size_t party_id, std::string& data) {
-    std::unique_lock<std::mutex> lck(mtx);
-    while(buffer[party_id].size() == 0) {
-        read_cv.wait(lck);
-    }
+    PADDLE_ENFORCE(_queues[party_id]->pop(data),
+                   "Grpc buffer is closed while reading from party %d.", party_id);
+}
 
-    data = buffer[party_id].front();
-    buffer[party_id].pop();
-    if (buffer[party_id].size() == BUFFER_LENGTH - 1) {
-        write_cv.notify_one();
+void GrpcBuffer::close() {
+    for (auto& queue : _queues) {
+        queue->close();
     }
 }
 
@@ -69,6 +65,95 @@ void TransportClient::send(const int party_id, const void* data, size_t size) {
     }
 }
 
+GrpcSendHandle::GrpcSendHandle(transport::Transport::Stub* stub,
+                               const int party_id,
+                               const void* data, size_t size)
+    : _is_done(false) {
+    _request.set_party_id(party_id);
+    _request.set_data(data, size);
+    _rpc = stub->Asyncsend_data(&_context, _request, &_cq);
+    _rpc->Finish(&_reply, &_status, this);
+}
+
+GrpcSendHandle::~GrpcSendHandle() {
+    try {
+        wait();
+    } catch (...) {
+        // completion queue must be drained before destroyed
+    }
+}
+
+void GrpcSendHandle::wait() {
+    if (_is_done) {
+        return;
+    }
+    _is_done = true;
+
+    void* tag = nullptr;
+    bool ok = false;
+    bool got = _cq.Next(&tag, &ok);
+    _cq.Shutdown();
+    while (_cq.Next(&tag, &ok)) {}
+
+    if (!got || !_status.ok()) {
+        VLOG(3) << "return code: " << _status.error_code() << ", error_message: " << _status.error_message();
+        PADDLE_THROW(platform::errors::Fatal(
+            "error: async send failed. return code: [%d], error message: [%s]",
+            _status.error_code(), _status.error_message()));
+    }
+}
+
+void GrpcRecvHandle::wait() {
+    if (_is_done) {
+        return;
+    }
+    _is_done = true;
+
+    // payload moved from grpc message is copied to caller's buffer once
+    std::string recv_data;
+    _buffer->read_buffer(_party_id, recv_data);
+    PADDLE_ENFORCE_EQ(recv_data.size(), _size,
+                      "Received size mismatches, party %d.", _party_id);
+    memcpy(_data, recv_data.data(), _size);
+}
+
+std::shared_ptr<AsyncHandle> TransportClient::async_send(const int party_id,
+                                                         const void* data, size_t size) {
+    return std::make_shared<GrpcSendHandle>(stub_.get(), party_id, data, size);
+}
+
+void TransportClient::open_stream() {
+    _stream_context.reset(new grpc::ClientContext);
+    _stream = stub_->stream_data(_stream_context.get());
+}
+
+void TransportClient::stream_send(const int party_id, const void* data, size_t size) {
+    _stream_request.set_party_id(party_id);
+    _stream_request.set_data(data, size);
+
+    if (!_stream->Write(_stream_request)) {
+        // stream is broken, fetch the status for error message
+        grpc::Status status = _stream->Finish();
+        _stream.reset();
+        PADDLE_THROW(platform::errors::Fatal(
+            "error: stream send failed. return code: [%d], error message: [%s]",
+            status.error_code(), status.error_message()));
+    }
+}
+
+void TransportClient::close_stream() {
+    if (!_stream) {
+        return;
+    }
+    _stream->WritesDone();
+    grpc::Status status = _stream->Finish();
+    if (!status.ok()) {
+        VLOG(3) << "close stream, return code: " << status.error_code()
+                << ", error_message: " << status.error_message();
+    }
+    _stream.reset();
+}
+
 // for test purpose
 void MeshNetworkGrpc::init() {
     if (_is_initialized) {
@@ -93,6 +178,9 @@ void MeshNetworkGrpc::init() {
                            "Failed to connect server [%s]", endpoints_vec[i]);
 
             client_map.insert(std::make_pair(i, TransportClient(channel)));
+            if (_use_stream) {
+                client_map[i].open_stream();
+            }
         }
     }
 
@@ -102,28 +190,89 @@ void MeshNetworkGrpc::init() {
 grpc::Status MeshNetworkGrpc::send_data(grpc::ServerContext* context, const transport::GrpcRequest* request,
                        transport::GrpcReply* reply) {
     // receive data from client and write into buffer
-    grpc_buffer.write_buffer(request->party_id(), request->data());
+    if (request->party_id() < 0 || request->party_id() >= (int) grpc_buffer.net_size()) {
+        return grpc::Status(grpc::StatusCode::INVALID_ARGUMENT, "invalid party id");
+    }
+    std::string data(request->data());
+    if (!grpc_buffer.write_buffer(request->party_id(), std::move(data))) {
+        return grpc::Status(grpc::StatusCode::CANCELLED, "network is shutting down");
+    }
     reply->set_ret_code(0);
     return grpc::Status::OK;
 }
 
+grpc::Status MeshNetworkGrpc::stream_data(grpc::ServerContext* context,
+                       grpc::ServerReaderWriter<transport::GrpcReply,
+                                                transport::GrpcRequest>* stream) {
+    // one stream per peer party, read until client calls WritesDone
+    transport::GrpcRequest request;
+    while (stream->Read(&request)) {
+        if (request.party_id() < 0 || request.party_id() >= (int) grpc_buffer.net_size()) {
+            return grpc::Status(grpc::StatusCode::INVALID_ARGUMENT, "invalid party id");
+        }
+        // payload is moved into buffer without copy,
+        // if buffer is full, stream flow control stalls the sender
+        if (!grpc_buffer.write_buffer(request.party_id(),
+                                      std::move(*request.mutable_data()))) {
+            return grpc::Status(grpc::StatusCode::CANCELLED, "network is shutting down");
+        }
+    }
+    return grpc::Status::OK;
+}
+
 
 void MeshNetworkGrpc::send(size_t party, const void *data, size_t size) {
     PADDLE_ENFORCE_NOT_NULL(data);
     PADDLE_ENFORCE(_is_initialized);
     PADDLE_ENFORCE_LT(party, _net_size, "Input role should be less than net_size.");
     PADDLE_ENFORCE_NE(party, _party_id, "Party should not send data to itself.");
+
+    if (_use_stream) {
+        client_map[party].stream_send(_party_id, data, size);
+        return;
+    }
+
+    auto pending = _pending_send.find(party);
+    if (pending != _pending_send.end()) {
+        pending->second->wait();
+        _pending_send.erase(pending);
+    }
     client_map[party].send(_party_id, data, size);
 }
 
 void MeshNetworkGrpc::recv(size_t party, void *data, size_t size) {
+    irecv(party, data, size)->wait();
+}
+
+std::shared_ptr<AsyncHandle> MeshNetworkGrpc::isend(size_t party, const void *data,
+                                                    size_t size) {
+    PADDLE_ENFORCE_NOT_NULL(data);
+    PADDLE_ENFORCE(_is_initialized);
+    PADDLE_ENFORCE_LT(party, _net_size, "Input role should be less than net_size.");
+    PADDLE_ENFORCE_NE(party, _party_id, "Party should not send data to itself.");
+
+    if (_use_stream) {
+        // stream writes of the same party are ordered by grpc
+        client_map[party].stream_send(_party_id, data, size);
+        return std::make_shared<GrpcStreamSendHandle>();
+    }
+
+    auto& pending = _pending_send[party];
+    if (pending) {
+        pending->wait();
+    }
+    // payload is copied into request, so data can be reused at once
+    pending = client_map[party].async_send(_party_id, data, size);
+    return pending;
+}
+
+std::shared_ptr<AsyncHandle> MeshNetworkGrpc::irecv(size_t party, void *data,
+                                                    size_t size) {
     PADDLE_ENFORCE_NOT_NULL(data);
     PADDLE_ENFORCE(_is_initialized);
     PADDLE_ENFORCE_NE(party, _party_id, "Party should not receive data from itself.");
 
-    std::string recv_data;
-    grpc_buffer.read_buffer(party, recv_data);
-    memcpy(data, (char*)recv_data.c_str(), size);
+    return std::make_shared<GrpcRecvHandle>(&grpc_buffer, party, data, size);
 }
 
 } // mpc
@@ -14,41 +14,92 @@
 
 #pragma once
 
+#include <chrono>
 #include <string>
-#include <queue>
 #include <vector>
 #include <unordered_map>
 #include <thread>
-#include <mutex>
-#include <condition_variable>
 
 #include "grpc++/grpc++.h"
 #include "paddle/fluid/platform/enforce.h"
 
 #include "core/paddlefl_mpc/mpc_protocol/abstract_network.h"
 #include "core/paddlefl_mpc/mpc_protocol/mpc_config.h"
+#include "core/paddlefl_mpc/mpc_protocol/network/spsc_queue.h"
 #include "core/paddlefl_mpc/mpc_protocol/transport.grpc.pb.h"
 
 namespace paddle {
 namespace mpc {
 
+// per-party message queues, written by grpc server threads and
+// read by the mpc thread
 class GrpcBuffer {
     public:
 
-        GrpcBuffer() : buffer(std::vector<std::queue<std::string>>(MAX_NET_SIZE)) {}
+        GrpcBuffer(size_t net_size = MAX_NET_SIZE, size_t depth = BUFFER_LENGTH);
 
-        void write_buffer(const size_t party_id, const std::string data);
+        // payload is moved into queue, false is returned if buffer is closed
+        bool write_buffer(const size_t party_id, std::string&& data);
 
         void read_buffer(const size_t party_id, std::string& data);
 
-    private:
-        static const int BUFFER_LENGTH = 1; // this version only supports BUFFER_LENGTH = 1.
+        // wake up blocked writers and readers, called on shutdown
+        void close();
+
+        size_t net_size() const { return _queues.size(); }
+
+        static const int BUFFER_LENGTH = 1;
         static const int MAX_NET_SIZE = 3;
-        std::vector<std::queue<std::string>> buffer;
 
-        std::mutex mtx;
-        std::condition_variable write_cv;
-        std::condition_variable read_cv;
+    private:
+        std::vector<std::unique_ptr<SpscQueue<std::string>>> _queues;
+};
+
+// completion handle of an async send_data rpc
+class GrpcSendHandle : public AsyncHandle {
+    public:
+        GrpcSendHandle(transport::Transport::Stub* stub, const int party_id,
+                       const void* data, size_t size);
+
+        ~GrpcSendHandle();
+
+        void wait() override;
+
+    private:
+        grpc::ClientContext _context;
+        grpc::CompletionQueue _cq;
+        transport::GrpcRequest _request;
+        transport::GrpcReply _reply;
+        grpc::Status _status;
+        std::unique_ptr<grpc::ClientAsyncResponseReader<transport::GrpcReply>> _rpc;
+        bool _is_done;
+};
+
+// completion handle of a recv from GrpcBuffer
+// data is taken from buffer when wait() is called, so recv handles
+// of the same party should be waited in the order they are issued
+class GrpcRecvHandle : public AsyncHandle {
+    public:
+        GrpcRecvHandle(GrpcBuffer* buffer, const size_t party_id,
+                       void* data, size_t size)
+            : _buffer(buffer), _party_id(party_id), _data(data),
+            _size(size), _is_done(false) {}
+
+        void wait() override;
+
+    private:
+        GrpcBuffer* _buffer;
+        const size_t _party_id;
+        void* _data;
+        const size_t _size;
+        bool _is_done;
+};
+
+// a stream write hands payload to grpc before it returns,
+// so there is nothing left to wait for
+class GrpcStreamSendHandle : public AsyncHandle {
+    public:
+        void wait() override {}
 };
 
 //gRPC client impl
@@ -60,21 +111,49 @@ class TransportClient {
 
         void send(const int party_id, const void* data, size_t size);
 
+        std::shared_ptr<AsyncHandle> async_send(const int party_id,
+                                                const void* data, size_t size);
+
+        // open the long-lived stream to server, messages sent by
+        // stream_send are delivered in order
+        void open_stream();
+
+        void stream_send(const int party_id, const void* data, size_t size);
+
+        void close_stream();
+
     private:
         std::unique_ptr<transport::Transport::Stub> stub_;
         static constexpr const size_t _max_retry = 3;
+
+        std::unique_ptr<grpc::ClientContext> _stream_context;
+        std::unique_ptr<grpc::ClientReaderWriter<transport::GrpcRequest,
+                                                 transport::GrpcReply>> _stream;
+        // reused by every stream write to save allocations
+        transport::GrpcRequest _stream_request;
 };
 
 class MeshNetworkGrpc : public paddle::mpc::AbstractNetwork, public transport::Transport::Service {
     public:
 
-        MeshNetworkGrpc(const size_t party_id, const size_t net_size, const std::string &endpoints)
+        // if use_stream is true, messages to each party are written to
+        // a long-lived bidi stream instead of one rpc per message,
+        // queue_depth is the num of messages buffered for each party
+        MeshNetworkGrpc(const size_t party_id, const size_t net_size, const std::string &endpoints,
+                        const bool use_stream = false,
+                        const size_t queue_depth = GrpcBuffer::BUFFER_LENGTH)
             : _party_id(party_id), _net_size(net_size), _endpoints(endpoints),
-            _is_initialized(false) {}
+            _use_stream(use_stream), _is_initialized(false),
+            grpc_buffer(net_size, queue_depth) {}
 
         ~MeshNetworkGrpc() {
+            for (auto& client : client_map) {
+                client.second.close_stream();
+            }
+            grpc_buffer.close();
             if (server != nullptr) {
-                server->Shutdown();
+                server->Shutdown(std::chrono::system_clock::now()
+                                 + std::chrono::seconds(_shutdown_timeout));
             }
         }
 
@@ -82,6 +161,12 @@ class MeshNetworkGrpc : public paddle::mpc::AbstractNetwork, public transport::T
 
         void recv(size_t party, void *data, size_t size) override;
 
+        std::shared_ptr<AsyncHandle> isend(size_t party, const void *data,
+                                           size_t size) override;
+
+        std::shared_ptr<AsyncHandle> irecv(size_t party, void *data,
+                                           size_t size) override;
+
         size_t party_id() const override { return _party_id; };
 
         size_t party_num() const override { return _net_size; };
@@ -91,6 +176,11 @@ class MeshNetworkGrpc : public paddle::mpc::AbstractNetwork, public transport::T
 
         grpc::Status send_data(grpc::ServerContext* context, const transport::GrpcRequest* request,
                        transport::GrpcReply* reply) override;
+
+        grpc::Status stream_data(grpc::ServerContext* context,
+                       grpc::ServerReaderWriter<transport::GrpcReply,
+                                                transport::GrpcRequest>* stream) override;
+
         // gRPC server: start server to listen
         void run_server(const std::string& server_address) {
             grpc::ServerBuilder builder;
@@ -106,10 +196,16 @@ class MeshNetworkGrpc : public paddle::mpc::AbstractNetwork, public transport::T
         const size_t _party_id;
         const size_t _net_size;
         const std::string _endpoints;
+        const bool _use_stream;
         bool _is_initialized;
         std::unique_ptr<grpc::Server> server;
         std::unordered_map<int, TransportClient> client_map;
         GrpcBuffer grpc_buffer;
+        // in-flight rpc of each party, rpcs to same party are issued
+        // one by one to keep message order
+        std::unordered_map<int, std::shared_ptr<AsyncHandle>> _pending_send;
+        // seconds to wait for in-flight rpcs on shutdown
+        static const int _shutdown_timeout = 1;
 
         void split(const std::string& s, std::vector<std::string>& tokens, const char& delim = ' ') {
             tokens.clear();
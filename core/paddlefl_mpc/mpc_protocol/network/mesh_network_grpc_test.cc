@@ -15,6 +15,7 @@
 #include "core/paddlefl_mpc/mpc_protocol/network/mesh_network_grpc.h"
 
 #include <thread>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -83,5 +84,99 @@ TEST_F(NetworkTest, basic_test) {
     EXPECT_EQ(1, buf[2]);
 }
 
+class StreamNetworkTest : public ::testing::Test {
+public:
+
+    std::string _endpoints;
+
+    std::shared_ptr<MeshNetworkGrpc> _n0;
+    std::shared_ptr<MeshNetworkGrpc> _n1;
+    std::shared_ptr<MeshNetworkGrpc> _n2;
+
+    StreamNetworkTest() : _endpoints("localhost:8910;localhost:8911;localhost:8912") {
+        _n0 = std::make_shared<MeshNetworkGrpc>(0, 3, _endpoints, true, 16);
+        _n1 = std::make_shared<MeshNetworkGrpc>(1, 3, _endpoints, true, 16);
+        _n2 = std::make_shared<MeshNetworkGrpc>(2, 3, _endpoints, true, 16);
+    }
+
+    void SetUp() {
+        std::thread t0([this]() { _n0->init(); });
+        std::thread t1([this]() { _n1->init(); });
+        std::thread t2([this]() { _n2->init(); });
+
+        t0.join();
+        t1.join();
+        t2.join();
+    }
+};
+
+TEST_F(StreamNetworkTest, ring_test) {
+    int buf[3] = {0, 1, 2};
+    std::thread t0([this, &buf]() {
+        _n0->template send(1, buf[0]);
+        buf[0] = _n0->template recv<int>(2);
+    });
+
+    std::thread t1([this, &buf]() {
+        int to_send = buf[1];
+        buf[1] = _n1->template recv<int>(0);
+        _n1->template send(2, to_send);
+    });
+
+    std::thread t2([this, &buf]() {
+        int to_send = buf[2];
+        buf[2] = _n2->template recv<int>(1);
+        _n2->template send(0, to_send);
+    });
+
+    t0.join();
+    t1.join();
+    t2.join();
+
+    EXPECT_EQ(2, buf[0]);
+    EXPECT_EQ(0, buf[1]);
+    EXPECT_EQ(1, buf[2]);
+}
+
+TEST_F(StreamNetworkTest, ordered_burst_test) {
+    // more messages than queue depth, sender is stalled by flow control
+    const int num = 1000;
+    std::vector<int> received(num, -1);
+    std::thread t0([this, num]() {
+        for (int i = 0; i < num; ++i) {
+            _n0->template send(1, i);
+        }
+    });
+
+    std::thread t1([this, num, &received]() {
+        for (int i = 0; i < num; ++i) {
+            received[i] = _n1->template recv<int>(0);
+        }
+    });
+
+    t0.join();
+    t1.join();
+
+    for (int i = 0; i < num; ++i) {
+        EXPECT_EQ(i, received[i]);
+    }
+}
+
+TEST_F(StreamNetworkTest, send_recv_test) {
+    int buf[2] = {0, 1};
+    std::thread t0([this, &buf]() {
+        buf[0] = _n0->template send_recv(1, buf[0], 1);
+    });
+
+    std::thread t1([this, &buf]() {
+        buf[1] = _n1->template send_recv(0, buf[1], 0);
+    });
+    t0.join();
+    t1.join();
+
+    EXPECT_EQ(1, buf[0]);
+    EXPECT_EQ(0, buf[1]);
+}
+
 } // namespace mpc
 } // namespace paddle
@@ -0,0 +1,320 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mesh_network_shm.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+
+#include "paddle/fluid/platform/enforce.h"
+#include "core/paddlefl_mpc/mpc_protocol/network/spsc_queue.h"
+
+namespace paddle {
+namespace mpc {
+
+namespace {
+
+// segment layout: attach counter, then rings
+const size_t SEGMENT_HEADER_SIZE = 64;
+
+std::atomic<uint64_t> *attach_counter(char *base) {
+  return reinterpret_cast<std::atomic<uint64_t> *>(base);
+}
+
+size_t ring_offset(size_t from, size_t to, size_t net_size,
+                   size_t ring_size) {
+  return SEGMENT_HEADER_SIZE
+         + (from * net_size + to) * ShmRing::footprint(ring_size);
+}
+
+// segments of current process, shared by threads in one run
+std::mutex g_segment_mutex;
+std::unordered_map<std::string, std::weak_ptr<ShmSegment>> g_segments;
+
+bool is_process_shared(const std::string &name) {
+  return !name.empty() && name[0] == '/';
+}
+
+} // namespace
+
+std::shared_ptr<ShmSegment> ShmSegment::open(const std::string &name,
+                                             size_t net_size,
+                                             size_t ring_size) {
+  size_t length = ring_offset(net_size, 0, net_size, ring_size);
+
+  if (is_process_shared(name)) {
+    int fd = shm_open(name.c_str(), O_CREAT | O_RDWR, 0600);
+    PADDLE_ENFORCE_GE(fd, 0, "shm_open [%s] failed, errno: %d.", name, errno);
+    // every party truncates to same length, new pages are zeroed
+    PADDLE_ENFORCE_EQ(ftruncate(fd, length), 0,
+                      "ftruncate [%s] failed, errno: %d.", name, errno);
+    return std::make_shared<ShmSegment>(fd, length, name);
+  }
+
+  std::lock_guard<std::mutex> lock(g_segment_mutex);
+  auto &entry = g_segments[name];
+  auto segment = entry.lock();
+  if (!segment) {
+    // anonymous shared mapping, also inherited by forked processes
+    segment = std::make_shared<ShmSegment>(-1, length, name);
+    entry = segment;
+  }
+  return segment;
+}
+
+ShmSegment::ShmSegment(int fd, size_t length, const std::string &name)
+    : _base(nullptr), _length(length), _name(name) {
+  int flags = MAP_SHARED | (fd < 0 ? MAP_ANONYMOUS : 0);
+  void *addr = mmap(nullptr, length, PROT_READ | PROT_WRITE, flags, fd, 0);
+  if (fd >= 0) {
+    close(fd);
+  }
+  PADDLE_ENFORCE_NE(addr, MAP_FAILED, "mmap [%s] failed, errno: %d.", name,
+                    errno);
+  _base = reinterpret_cast<char *>(addr);
+}
+
+ShmSegment::~ShmSegment() { munmap(_base, _length); }
+
+void ShmSegment::unlink() {
+  if (is_process_shared(_name)) {
+    shm_unlink(_name.c_str());
+    return;
+  }
+  std::lock_guard<std::mutex> lock(g_segment_mutex);
+  auto got = g_segments.find(_name);
+  if (got != g_segments.end() && got->second.lock().get() == this) {
+    g_segments.erase(got);
+  }
+}
+
+size_t ShmRing::write(const char *data, size_t size) {
+  uint64_t tail = _header->tail.load(std::memory_order_relaxed);
+  uint64_t head = _header->head.load(std::memory_order_acquire);
+  size_t len = std::min(size, _capacity - static_cast<size_t>(tail - head));
+  if (len == 0) {
+    return 0;
+  }
+  size_t pos = tail % _capacity;
+  size_t first = std::min(len, _capacity - pos);
+  memcpy(_data + pos, data, first);
+  memcpy(_data, data + first, len - first);
+  _header->tail.store(tail + len, std::memory_order_release);
+  return len;
+}
+
+size_t ShmRing::read(char *data, size_t size) {
+  uint64_t head = _header->head.load(std::memory_order_relaxed);
+  uint64_t tail = _header->tail.load(std::memory_order_acquire);
+  size_t len = std::min(size, static_cast<size_t>(tail - head));
+  if (len == 0) {
+    return 0;
+  }
+  size_t pos = head % _capacity;
+  size_t first = std::min(len, _capacity - pos);
+  memcpy(data, _data + pos, first);
+  memcpy(data + first, _data, len - first);
+  _header->head.store(head + len, std::memory_order_release);
+  return len;
+}
+
+void ShmHandle::wait() { _net->wait(_op); }
+
+void MeshNetworkShm::init() {
+  if (_is_initialized) {
+    return;
+  }
+  PADDLE_ENFORCE_LT(_party_id, _net_size, "Input role should be less than net_size.");
+  PADDLE_ENFORCE(_ring_size > 0 && _ring_size % 64 == 0,
+                 "Ring size should be a positive multiple of 64.");
+
+  _segment = ShmSegment::open(_name, _net_size, _ring_size);
+  char *base = _segment->base();
+
+  _peers.resize(_net_size);
+  for (size_t i = 0; i < _net_size; ++i) {
+    if (i == _party_id) {
+      continue;
+    }
+    _peers[i].send_ring = ShmRing(
+        base + ring_offset(_party_id, i, _net_size, _ring_size), _ring_size);
+    _peers[i].recv_ring = ShmRing(
+        base + ring_offset(i, _party_id, _net_size, _ring_size), _ring_size);
+  }
+
+  // barrier, the last party to attach removes the name so that
+  // a later run with same name gets a fresh segment
+  auto counter = attach_counter(base);
+  if (counter->fetch_add(1) + 1 == _net_size) {
+    _segment->unlink();
+  }
+  auto deadline = std::chrono::steady_clock::now()
+                  + std::chrono::seconds(ATTACH_TIMEOUT);
+  for (size_t round = 0; counter->load() < _net_size; ++round) {
+    PADDLE_ENFORCE(std::chrono::steady_clock::now() < deadline,
+                   "Timeout waiting for parties to attach [%s].", _name);
+    spsc_backoff(round);
+  }
+
+  _is_initialized = true;
+}
+
+std::shared_ptr<AbstractNetwork> MeshNetworkShm::channel(size_t id) {
+  PADDLE_ENFORCE(_is_initialized);
+  PADDLE_ENFORCE_GT(id, 0, "Channel 0 is the network itself.");
+
+  auto net = std::make_shared<MeshNetworkShm>(
+      _party_id, _net_size, _name + ".ch" + std::to_string(id), _ring_size);
+  net->init();
+  return net;
+}
+
+void MeshNetworkShm::enforce_party(size_t party) {
+  PADDLE_ENFORCE(_is_initialized);
+  PADDLE_ENFORCE_LT(party, _net_size, "Input role should be less than net_size.");
+  PADDLE_ENFORCE_NE(party, _party_id, "Party should not send data to itself.");
+}
+
+void MeshNetworkShm::send(size_t party, const void *data, size_t size) {
+  isend(party, data, size)->wait();
+}
+
+void MeshNetworkShm::recv(size_t party, void *data, size_t size) {
+  irecv(party, data, size)->wait();
+}
+
+std::shared_ptr<AsyncHandle> MeshNetworkShm::isend(size_t party,
+                                                   const void *data,
+                                                   size_t size) {
+  PADDLE_ENFORCE_NOT_NULL(data);
+  enforce_party(party);
+
+  auto op = std::make_shared<ShmOp>(
+      const_cast<char *>(reinterpret_cast<const char *>(data)), size);
+  auto &peer = _peers[party];
+  peer.sends.emplace_back(op);
+  if (peer.sends.size() == 1) {
+    advance_send(peer);
+  }
+  return std::make_shared<ShmHandle>(this, std::move(op));
+}
+
+std::shared_ptr<AsyncHandle> MeshNetworkShm::irecv(size_t party, void *data,
+                                                   size_t size) {
+  PADDLE_ENFORCE_NOT_NULL(data);
+  enforce_party(party);
+
+  auto op = std::make_shared<ShmOp>(reinterpret_cast<char *>(data), size);
+  _peers[party].recvs.emplace_back(op);
+  return std::make_shared<ShmHandle>(this, std::move(op));
+}
+
+void MeshNetworkShm::recv_any(size_t party, std::vector<char> &data) {
+  enforce_party(party);
+
+  auto op = std::make_shared<ShmOp>(&data);
+  _peers[party].recvs.emplace_back(op);
+  wait(op);
+}
+
+void MeshNetworkShm::wait(const std::shared_ptr<ShmOp> &op) {
+  for (size_t round = 0; !op->finished; ++round) {
+    if (progress()) {
+      round = 0;
+    } else {
+      spsc_backoff(round);
+    }
+  }
+}
+
+bool MeshNetworkShm::advance_send(Peer &peer) {
+  bool advanced = false;
+  while (!peer.sends.empty()) {
+    auto &op = *peer.sends.front();
+    const size_t header_size = sizeof(op.header);
+    if (op.done < header_size) {
+      size_t n = peer.send_ring.write(
+          reinterpret_cast<char *>(&op.header) + op.done,
+          header_size - op.done);
+      op.done += n;
+      advanced = advanced || n > 0;
+      if (op.done < header_size) {
+        break;
+      }
+    }
+    size_t offset = op.done - header_size;
+    size_t n = peer.send_ring.write(op.data + offset, op.size - offset);
+    op.done += n;
+    advanced = advanced || n > 0;
+    if (op.done < header_size + op.size) {
+      break;
+    }
+    op.finished = true;
+    peer.sends.pop_front();
+  }
+  return advanced;
+}
+
+bool MeshNetworkShm::advance_recv(Peer &peer) {
+  bool advanced = false;
+  while (!peer.recvs.empty()) {
+    auto &op = *peer.recvs.front();
+    const size_t header_size = sizeof(op.header);
+    if (op.done < header_size) {
+      size_t n = peer.recv_ring.read(
+          reinterpret_cast<char *>(&op.header) + op.done,
+          header_size - op.done);
+      op.done += n;
+      advanced = advanced || n > 0;
+      if (op.done < header_size) {
+        break;
+      }
+      op.on_header();
+    }
+    // payload is copied from ring to caller's buffer directly
+    size_t offset = op.done - header_size;
+    size_t n = peer.recv_ring.read(op.data + offset, op.size - offset);
+    op.done += n;
+    advanced = advanced || n > 0;
+    if (op.done < header_size + op.size) {
+      break;
+    }
+    op.finished = true;
+    peer.recvs.pop_front();
+  }
+  return advanced;
+}
+
+bool MeshNetworkShm::progress() {
+  bool advanced = false;
+  for (size_t i = 0; i < _net_size; ++i) {
+    if (i == _party_id) {
+      continue;
+    }
+    advanced = advance_send(_peers[i]) || advanced;
+    advanced = advance_recv(_peers[i]) || advanced;
+  }
+  return advanced;
+}
+
+} // mpc
+} // paddle
@@ -0,0 +1,236 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/paddlefl_mpc/mpc_protocol/abstract_network.h"
+#include "core/paddlefl_mpc/mpc_protocol/mpc_config.h"
+
+namespace paddle {
+namespace mpc {
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2,
+              "shared memory ring requires lock-free 64-bit atomics");
+
+// a mapped shared memory region holding net_size * net_size byte rings,
+// ring (i, j) carries messages from party i to party j
+class ShmSegment {
+public:
+  // name starting with '/' is opened by shm_open and can be shared by
+  // processes on one host, otherwise it is an anonymous shared mapping
+  // shared by threads of current process (and inherited by fork)
+  static std::shared_ptr<ShmSegment> open(const std::string &name,
+                                          size_t net_size, size_t ring_size);
+
+  ShmSegment(int fd, size_t length, const std::string &name);
+
+  ~ShmSegment();
+
+  ShmSegment(const ShmSegment &other) = delete;
+
+  ShmSegment &operator=(const ShmSegment &other) = delete;
+
+  // remove the name, mapped memory stays valid for current users
+  void unlink();
+
+  char *base() const { return _base; }
+
+  const std::string &name() const { return _name; }
+
+private:
+  char *_base;
+  size_t _length;
+  const std::string _name;
+};
+
+// single-producer single-consumer byte ring living in shared memory,
+// positions increase monotonically and are taken modulo capacity
+class ShmRing {
+public:
+  struct Header {
+    alignas(64) std::atomic<uint64_t> head;
+    alignas(64) std::atomic<uint64_t> tail;
+  };
+
+  ShmRing() : _header(nullptr), _data(nullptr), _capacity(0) {}
+
+  ShmRing(char *base, size_t capacity)
+      : _header(reinterpret_cast<Header *>(base)),
+        _data(base + sizeof(Header)), _capacity(capacity) {}
+
+  // copy as many bytes as fit, return num of bytes written
+  size_t write(const char *data, size_t size);
+
+  // copy as many bytes as available, return num of bytes read
+  size_t read(char *data, size_t size);
+
+  static size_t footprint(size_t capacity) {
+    return sizeof(Header) + capacity;
+  }
+
+private:
+  Header *_header;
+  char *_data;
+  size_t _capacity;
+};
+
+// a pending send or recv of one message, a message is a 8-byte
+// payload size followed by payload
+struct ShmOp {
+  ShmOp(char *data, size_t size)
+      : data(data), size(size), header(size), done(0), finished(false),
+        any(nullptr) {}
+
+  // recv of a message of any size, payload is appended to any
+  explicit ShmOp(std::vector<char> *any)
+      : data(nullptr), size(0), header(0), done(0), finished(false),
+        any(any) {}
+
+  // called when header of a recv is read
+  void on_header() {
+    if (any == nullptr) {
+      PADDLE_ENFORCE_EQ(header, size,
+                        "Received size mismatches expected size.");
+      return;
+    }
+    auto offset = any->size();
+    any->resize(offset + header);
+    data = any->data() + offset;
+    size = header;
+  }
+
+  char *data;
+  size_t size;
+  uint64_t header;
+  // bytes transferred, including header
+  size_t done;
+  bool finished;
+  std::vector<char> *any;
+};
+
+class MeshNetworkShm;
+
+// waiting on any handle drives all pending ops of the network
+class ShmHandle : public AsyncHandle {
+public:
+  ShmHandle(MeshNetworkShm *net, std::shared_ptr<ShmOp> op)
+      : _net(net), _op(std::move(op)) {}
+
+  ~ShmHandle() {
+    try {
+      wait();
+    } catch (...) {
+      // op must not be released while peer may touch its buffer
+    }
+  }
+
+  void wait() override;
+
+private:
+  MeshNetworkShm *_net;
+  std::shared_ptr<ShmOp> _op;
+};
+
+// A full-connected network for parties on one host, connected by
+// lock-free rings in shared memory. Network cost is a memcpy, so it
+// is suitable for tests and for benchmarking pure compute cost.
+class MeshNetworkShm : public paddle::mpc::AbstractNetwork {
+public:
+  // name: shared memory name, should be unique for each run
+  // example:
+  // (in each thread or process:)
+  //     paddle::mpc::MeshNetworkShm net(0, 3, "/paddle_mpc");
+  //     net.init();
+  //     net.send(1, data, sizeof(data))
+  MeshNetworkShm(const size_t party_id, const size_t net_size,
+                 const std::string &name,
+                 const size_t ring_size = RING_SIZE_DEFAULT)
+      : _party_id(party_id), _net_size(net_size), _name(name),
+        _ring_size(ring_size), _is_initialized(false) {}
+
+  virtual ~MeshNetworkShm() = default;
+
+  void send(size_t party, const void *data, size_t size) override;
+
+  void recv(size_t party, void *data, size_t size) override;
+
+  std::shared_ptr<AsyncHandle> isend(size_t party, const void *data,
+                                     size_t size) override;
+
+  std::shared_ptr<AsyncHandle> irecv(size_t party, void *data,
+                                     size_t size) override;
+
+  // sizes are on wire, a message of any size is sent as is
+  std::shared_ptr<AsyncHandle> isend_any(size_t party, const void *data,
+                                         size_t size) override {
+    return isend(party, data, size);
+  }
+
+  void recv_any(size_t party, std::vector<char> &data) override;
+
+  size_t party_id() const override { return _party_id; };
+
+  size_t party_num() const override { return _net_size; };
+
+  // must be called before use, blocks until all parties are attached
+  void init();
+
+  // a channel is a network on its own segment named after this one
+  std::shared_ptr<AbstractNetwork> channel(size_t id) override;
+
+  // block until op is finished
+  void wait(const std::shared_ptr<ShmOp> &op);
+
+  static const size_t RING_SIZE_DEFAULT = 4 << 20;
+
+  // seconds to wait for peers on init
+  static const int ATTACH_TIMEOUT = 100;
+
+private:
+  struct Peer {
+    ShmRing send_ring;
+    ShmRing recv_ring;
+    std::deque<std::shared_ptr<ShmOp>> sends;
+    std::deque<std::shared_ptr<ShmOp>> recvs;
+  };
+
+  // advance ops of all peers, return true if any bytes are transferred
+  bool progress();
+
+  bool advance_send(Peer &peer);
+
+  bool advance_recv(Peer &peer);
+
+  void enforce_party(size_t party);
+
+  const size_t _party_id;
+  const size_t _net_size;
+  const std::string _name;
+  const size_t _ring_size;
+
+  std::shared_ptr<ShmSegment> _segment;
+  std::vector<Peer> _peers;
+
+  bool _is_initialized;
+};
+
+} // mpc
+} // paddle
@@ -0,0 +1,169 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "core/paddlefl_mpc/mpc_protocol/network/mesh_network_shm.h"
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace paddle {
+namespace mpc {
+
+class NetworkTest : public ::testing::Test {
+public:
+  std::shared_ptr<AbstractNetwork> _p0;
+  std::shared_ptr<AbstractNetwork> _p1;
+  std::shared_ptr<AbstractNetwork> _p2;
+
+  void SetUp() {
+    // small rings so that messages wrap around and are split
+    _p0 = std::make_shared<MeshNetworkShm>(0, 3, "test_shm", 1024);
+    _p1 = std::make_shared<MeshNetworkShm>(1, 3, "test_shm", 1024);
+    _p2 = std::make_shared<MeshNetworkShm>(2, 3, "test_shm", 1024);
+
+    std::thread t0([this]() { _p0->init(); });
+    std::thread t1([this]() { _p1->init(); });
+    std::thread t2([this]() { _p2->init(); });
+
+    t0.join();
+    t1.join();
+    t2.join();
+  }
+};
+
+TEST_F(NetworkTest, basic_test) {
+  int buf[3] = {0, 1, 2};
+  std::thread t0([this, &buf]() {
+    _p0->template send(1, buf[0]);
+    buf[0] = _p0->template recv<int>(2);
+  });
+
+  std::thread t1([this, &buf]() {
+    int to_send = buf[1];
+    buf[1] = _p1->template recv<int>(0);
+    _p1->template send(2, to_send);
+  });
+
+  std::thread t2([this, &buf]() {
+    int to_send = buf[2];
+    buf[2] = _p2->template recv<int>(1);
+    _p2->template send(0, to_send);
+  });
+
+  t0.join();
+  t1.join();
+  t2.join();
+
+  EXPECT_EQ(2, buf[0]);
+  EXPECT_EQ(0, buf[1]);
+  EXPECT_EQ(1, buf[2]);
+}
+
+TEST_F(NetworkTest, large_send_recv_test) {
+  // payload much larger than rings
+  const size_t num = 1 << 20;
+  std::vector<char> in0(num);
+  std::vector<char> in1(num);
+  for (size_t i = 0; i < num; ++i) {
+    in0[i] = i % 127;
+    in1[i] = i % 131;
+  }
+  std::vector<char> out0(num);
+  std::vector<char> out1(num);
+
+  std::thread t0([&]() {
+    _p0->send_recv(1, in0.data(), num, 1, out0.data(), num);
+  });
+
+  std::thread t1([&]() {
+    _p1->send_recv(0, in1.data(), num, 0, out1.data(), num);
+  });
+  t0.join();
+  t1.join();
+
+  EXPECT_EQ(in1, out0);
+  EXPECT_EQ(in0, out1);
+}
+
+TEST_F(NetworkTest, channel_test) {
+  // each channel is used by its own thread on each party
+  const size_t num_channels = 2;
+  const int num_msgs = 1000;
+  std::shared_ptr<AbstractNetwork> nets[3] = {_p0, _p1, _p2};
+  std::vector<std::thread> threads;
+  std::vector<int> errors(3 * num_channels, 0);
+
+  for (size_t party = 0; party < 3; ++party) {
+    for (size_t ch = 1; ch <= num_channels; ++ch) {
+      threads.emplace_back([&, party, ch]() {
+        auto net = nets[party]->channel(ch);
+        size_t next = (party + 1) % 3;
+        size_t pre = (party + 2) % 3;
+        for (int i = 0; i < num_msgs; ++i) {
+          int to_send = ch * 100 + party + i;
+          int expected = ch * 100 + pre + i;
+          if (net->template send_recv(next, to_send, pre) != expected) {
+            ++errors[party * num_channels + ch - 1];
+          }
+        }
+      });
+    }
+  }
+
+  for (auto &t : threads) {
+    t.join();
+  }
+
+  for (auto e : errors) {
+    EXPECT_EQ(0, e);
+  }
+}
+
+TEST(MeshNetworkShmTest, multi_process_test) {
+  std::string name = "/paddle_mpc_shm_test_" + std::to_string(getpid());
+  pid_t children[2];
+  for (size_t i = 1; i < 3; ++i) {
+    children[i - 1] = fork();
+    if (children[i - 1] == 0) {
+      // child: pass own id to next party, check the one from previous
+      std::shared_ptr<AbstractNetwork> net =
+          std::make_shared<MeshNetworkShm>(i, 3, name);
+      net->init();
+      net->template send((i + 1) % 3, (int) i);
+      int got = net->template recv<int>((i + 2) % 3);
+      _exit(got == (int) (i + 2) % 3 ? 0 : 1);
+    }
+  }
+
+  std::shared_ptr<AbstractNetwork> net =
+      std::make_shared<MeshNetworkShm>(0, 3, name);
+  net->init();
+  net->template send(1, 0);
+  EXPECT_EQ(2, net->template recv<int>(2));
+
+  for (auto pid : children) {
+    int status = -1;
+    waitpid(pid, &status, 0);
+    EXPECT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(0, WEXITSTATUS(status));
+  }
+}
+
+} // namespace mpc
+} // namespace paddle
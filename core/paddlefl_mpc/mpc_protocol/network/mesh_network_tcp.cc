@@ -0,0 +1,435 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mesh_network_tcp.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+#include "paddle/fluid/platform/enforce.h"
+
+namespace paddle {
+namespace mpc {
+
+namespace {
+
+void split_endpoints(const std::string &endpoints,
+                     std::vector<std::string> &tokens) {
+  tokens.clear();
+  size_t begin = 0;
+  while (begin <= endpoints.size()) {
+    size_t end = endpoints.find(';', begin);
+    if (end == std::string::npos) {
+      end = endpoints.size();
+    }
+    auto token = endpoints.substr(begin, end - begin);
+    token.erase(0, token.find_first_not_of(" "));
+    token.erase(token.find_last_not_of(" ") + 1);
+    if (!token.empty()) {
+      tokens.emplace_back(token);
+    }
+    begin = end + 1;
+  }
+}
+
+void split_host_port(const std::string &endpoint, std::string &host,
+                     std::string &port) {
+  auto pos = endpoint.rfind(':');
+  PADDLE_ENFORCE_NE(pos, std::string::npos,
+                    "Endpoint should be host:port, got %s.", endpoint);
+  host = endpoint.substr(0, pos);
+  port = endpoint.substr(pos + 1);
+}
+
+void set_socket_options(int fd) {
+  int one = 1;
+  int buf_size = MeshNetworkTcp::SOCKET_BUFFER_SIZE;
+  setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+  setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &buf_size, sizeof(buf_size));
+  setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &buf_size, sizeof(buf_size));
+}
+
+void set_nonblocking(int fd) {
+  int flags = fcntl(fd, F_GETFL, 0);
+  PADDLE_ENFORCE_GE(flags, 0, "fcntl failed, errno: %d.", errno);
+  PADDLE_ENFORCE_EQ(fcntl(fd, F_SETFL, flags | O_NONBLOCK), 0,
+                    "fcntl failed, errno: %d.", errno);
+}
+
+// blocking io, used by handshake only
+void write_all(int fd, const void *data, size_t size) {
+  auto ptr = reinterpret_cast<const char *>(data);
+  while (size > 0) {
+    auto n = ::send(fd, ptr, size, MSG_NOSIGNAL);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    PADDLE_ENFORCE_GT(n, 0, "Handshake send failed, errno: %d.", errno);
+    ptr += n;
+    size -= n;
+  }
+}
+
+void read_all(int fd, void *data, size_t size) {
+  auto ptr = reinterpret_cast<char *>(data);
+  while (size > 0) {
+    auto n = ::recv(fd, ptr, size, 0);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    PADDLE_ENFORCE_GT(n, 0, "Handshake recv failed, errno: %d.", errno);
+    ptr += n;
+    size -= n;
+  }
+}
+
+int listen_on(const std::string &endpoint) {
+  std::string host;
+  std::string port;
+  split_host_port(endpoint, host, port);
+
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+  PADDLE_ENFORCE_GE(fd, 0, "Failed to create socket, errno: %d.", errno);
+  int one = 1;
+  setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+  // accepted sockets inherit buffer sizes, which must be set
+  // before listen to take effect on tcp window scaling
+  set_socket_options(fd);
+
+  sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_ANY);
+  addr.sin_port = htons(std::stoi(port));
+  PADDLE_ENFORCE_EQ(bind(fd, reinterpret_cast<sockaddr *>(&addr),
+                         sizeof(addr)), 0,
+                    "Failed to bind [%s], errno: %d.", endpoint, errno);
+  PADDLE_ENFORCE_EQ(listen(fd, SOMAXCONN), 0,
+                    "Failed to listen [%s], errno: %d.", endpoint, errno);
+  return fd;
+}
+
+// retry until peer is listening or timeout
+int connect_to(const std::string &endpoint, int timeout) {
+  std::string host;
+  std::string port;
+  split_host_port(endpoint, host, port);
+
+  addrinfo hints;
+  memset(&hints, 0, sizeof(hints));
+  hints.ai_family = AF_INET;
+  hints.ai_socktype = SOCK_STREAM;
+  addrinfo *res = nullptr;
+  int ret = getaddrinfo(host.c_str(), port.c_str(), &hints, &res);
+  PADDLE_ENFORCE_EQ(ret, 0, "Failed to resolve [%s]: %s.", endpoint,
+                    gai_strerror(ret));
+
+  auto deadline =
+      std::chrono::steady_clock::now() + std::chrono::seconds(timeout);
+  int fd = -1;
+  while (true) {
+    fd = socket(AF_INET, SOCK_STREAM, 0);
+    PADDLE_ENFORCE_GE(fd, 0, "Failed to create socket, errno: %d.", errno);
+    set_socket_options(fd);
+    if (connect(fd, res->ai_addr, res->ai_addrlen) == 0) {
+      break;
+    }
+    close(fd);
+    fd = -1;
+    if (std::chrono::steady_clock::now() > deadline) {
+      break;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  }
+  freeaddrinfo(res);
+  PADDLE_ENFORCE_GE(fd, 0, "Failed to connect server [%s]", endpoint);
+  return fd;
+}
+
+} // namespace
+
+void TcpHandle::wait() { _net->wait(_op); }
+
+MeshNetworkTcp::~MeshNetworkTcp() {
+  for (auto &peer : _peers) {
+    if (peer.fd >= 0) {
+      close(peer.fd);
+    }
+  }
+  if (_epoll_fd >= 0) {
+    close(_epoll_fd);
+  }
+}
+
+void MeshNetworkTcp::init() {
+  if (_is_initialized) {
+    return;
+  }
+
+  std::vector<std::string> endpoints;
+  split_endpoints(_endpoints, endpoints);
+  PADDLE_ENFORCE_EQ(endpoints.size(), _net_size,
+                    "Num of endpoints should be equal to net size.");
+
+  _peers.resize(_net_size);
+  int listen_fd = listen_on(endpoints[_party_id]);
+
+  // every party listens before connecting, pending connections from
+  // larger ids wait in the backlog, so the order below cannot deadlock
+  for (size_t i = 0; i < _party_id; ++i) {
+    int fd = connect_to(endpoints[i], CONNECT_TIMEOUT);
+    uint64_t id = _party_id;
+    write_all(fd, &id, sizeof(id));
+    _peers[i].fd = fd;
+  }
+
+  for (size_t i = _party_id + 1; i < _net_size; ++i) {
+    int fd = -1;
+    do {
+      fd = accept(listen_fd, nullptr, nullptr);
+    } while (fd < 0 && errno == EINTR);
+    PADDLE_ENFORCE_GE(fd, 0, "Failed to accept, errno: %d.", errno);
+    set_socket_options(fd);
+    uint64_t id = 0;
+    read_all(fd, &id, sizeof(id));
+    PADDLE_ENFORCE(id > _party_id && id < _net_size && _peers[id].fd < 0,
+                   "Unexpected connection from party %d.", id);
+    _peers[id].fd = fd;
+  }
+  close(listen_fd);
+
+  _epoll_fd = epoll_create1(0);
+  PADDLE_ENFORCE_GE(_epoll_fd, 0, "epoll_create failed, errno: %d.", errno);
+  for (size_t i = 0; i < _net_size; ++i) {
+    if (i == _party_id) {
+      continue;
+    }
+    set_nonblocking(_peers[i].fd);
+    epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = 0;
+    ev.data.u64 = i;
+    PADDLE_ENFORCE_EQ(epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, _peers[i].fd, &ev),
+                      0, "epoll_ctl failed, errno: %d.", errno);
+  }
+
+  _is_initialized = true;
+}
+
+void MeshNetworkTcp::enforce_party(size_t party) {
+  PADDLE_ENFORCE(_is_initialized);
+  PADDLE_ENFORCE_LT(party, _net_size, "Input role should be less than net_size.");
+  PADDLE_ENFORCE_NE(party, _party_id, "Party should not send data to itself.");
+}
+
+void MeshNetworkTcp::send(size_t party, const void *data, size_t size) {
+  isend(party, data, size)->wait();
+}
+
+void MeshNetworkTcp::recv(size_t party, void *data, size_t size) {
+  irecv(party, data, size)->wait();
+}
+
+std::shared_ptr<AsyncHandle> MeshNetworkTcp::isend(size_t party,
+                                                   const void *data,
+                                                   size_t size) {
+  PADDLE_ENFORCE_NOT_NULL(data);
+  enforce_party(party);
+
+  auto op = std::make_shared<TcpOp>(
+      const_cast<char *>(reinterpret_cast<const char *>(data)), size);
+  auto &peer = _peers[party];
+  peer.sends.emplace_back(op);
+  // try to write at once, most messages fit in socket buffer
+  if (peer.sends.size() == 1) {
+    advance_send(peer);
+  }
+  return std::make_shared<TcpHandle>(this, std::move(op));
+}
+
+std::shared_ptr<AsyncHandle> MeshNetworkTcp::irecv(size_t party, void *data,
+                                                   size_t size) {
+  PADDLE_ENFORCE_NOT_NULL(data);
+  enforce_party(party);
+
+  auto op = std::make_shared<TcpOp>(reinterpret_cast<char *>(data), size);
+  _peers[party].recvs.emplace_back(op);
+  return std::make_shared<TcpHandle>(this, std::move(op));
+}
+
+void MeshNetworkTcp::recv_any(size_t party, std::vector<char> &data) {
+  enforce_party(party);
+
+  auto op = std::make_shared<TcpOp>(&data);
+  _peers[party].recvs.emplace_back(op);
+  wait(op);
+}
+
+void MeshNetworkTcp::wait(const std::shared_ptr<TcpOp> &op) {
+  while (!op->finished) {
+    progress();
+  }
+}
+
+bool MeshNetworkTcp::advance_send(Peer &peer) {
+  bool advanced = false;
+  while (!peer.sends.empty()) {
+    auto &op = *peer.sends.front();
+    const size_t header_size = sizeof(op.header);
+
+    // header and payload are gathered in one syscall
+    iovec iov[2];
+    int iov_num = 0;
+    if (op.done < header_size) {
+      iov[iov_num].iov_base = reinterpret_cast<char *>(&op.header) + op.done;
+      iov[iov_num].iov_len = header_size - op.done;
+      ++iov_num;
+      iov[iov_num].iov_base = op.data;
+      iov[iov_num].iov_len = op.size;
+      ++iov_num;
+    } else {
+      iov[iov_num].iov_base = op.data + (op.done - header_size);
+      iov[iov_num].iov_len = op.size - (op.done - header_size);
+      ++iov_num;
+    }
+
+    msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = iov;
+    msg.msg_iovlen = iov_num;
+    auto n = sendmsg(peer.fd, &msg, MSG_NOSIGNAL);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      if (errno == EAGAIN || errno == EWOULDBLOCK) {
+        break;
+      }
+      PADDLE_THROW(platform::errors::Fatal(
+          "error: tcp send failed, errno: [%d].", errno));
+    }
+    advanced = advanced || n > 0;
+    op.done += n;
+    if (op.done == header_size + op.size) {
+      op.finished = true;
+      peer.sends.pop_front();
+    }
+  }
+  return advanced;
+}
+
+bool MeshNetworkTcp::advance_recv(Peer &peer) {
+  bool advanced = false;
+  while (!peer.recvs.empty()) {
+    auto &op = *peer.recvs.front();
+    const size_t header_size = sizeof(op.header);
+
+    // payload is read directly into caller's buffer, sizes are checked
+    // when header is complete
+    iovec iov[2];
+    int iov_num = 0;
+    if (op.done < header_size) {
+      iov[iov_num].iov_base = reinterpret_cast<char *>(&op.header) + op.done;
+      iov[iov_num].iov_len = header_size - op.done;
+      ++iov_num;
+      iov[iov_num].iov_base = op.data;
+      iov[iov_num].iov_len = op.size;
+      ++iov_num;
+    } else {
+      iov[iov_num].iov_base = op.data + (op.done - header_size);
+      iov[iov_num].iov_len = op.size - (op.done - header_size);
+      ++iov_num;
+    }
+
+    auto n = readv(peer.fd, iov, iov_num);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      if (errno == EAGAIN || errno == EWOULDBLOCK) {
+        break;
+      }
+      PADDLE_THROW(platform::errors::Fatal(
+          "error: tcp recv failed, errno: [%d].", errno));
+    }
+    if (n == 0 && op.done < header_size + op.size) {
+      PADDLE_THROW(platform::errors::Fatal(
+          "error: tcp connection closed by peer."));
+    }
+    bool header_done = op.done >= header_size;
+    advanced = true;
+    op.done += n;
+    if (!header_done && op.done >= header_size) {
+      op.on_header();
+    }
+    if (op.done == header_size + op.size) {
+      op.finished = true;
+      peer.recvs.pop_front();
+    }
+  }
+  return advanced;
+}
+
+void MeshNetworkTcp::progress() {
+  bool advanced = false;
+  for (size_t i = 0; i < _net_size; ++i) {
+    if (i == _party_id) {
+      continue;
+    }
+    advanced = advance_send(_peers[i]) || advanced;
+    advanced = advance_recv(_peers[i]) || advanced;
+  }
+  if (advanced) {
+    return;
+  }
+
+  // nothing to do without blocking, wait for sockets with pending ops
+  for (size_t i = 0; i < _net_size; ++i) {
+    if (i == _party_id) {
+      continue;
+    }
+    auto &peer = _peers[i];
+    uint32_t events = (peer.sends.empty() ? 0 : EPOLLOUT)
+                      | (peer.recvs.empty() ? 0 : EPOLLIN);
+    if (events != peer.events) {
+      epoll_event ev;
+      memset(&ev, 0, sizeof(ev));
+      ev.events = events;
+      ev.data.u64 = i;
+      PADDLE_ENFORCE_EQ(epoll_ctl(_epoll_fd, EPOLL_CTL_MOD, peer.fd, &ev),
+                        0, "epoll_ctl failed, errno: %d.", errno);
+      peer.events = events;
+    }
+  }
+
+  epoll_event events[8];
+  int n = epoll_wait(_epoll_fd, events, 8, -1);
+  if (n < 0) {
+    PADDLE_ENFORCE_EQ(errno, EINTR, "epoll_wait failed, errno: %d.", errno);
+  }
+}
+
+} // mpc
+} // paddle
@@ -0,0 +1,172 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/paddlefl_mpc/mpc_protocol/abstract_network.h"
+#include "core/paddlefl_mpc/mpc_protocol/mpc_config.h"
+
+namespace paddle {
+namespace mpc {
+
+class MeshNetworkTcp;
+
+// a pending send or recv of one message
+// on wire, a message is a 8-byte payload size followed by payload
+struct TcpOp {
+  TcpOp(char *data, size_t size)
+      : data(data), size(size), header(size), done(0), finished(false),
+        any(nullptr) {}
+
+  // recv of a message of any size, payload is appended to any
+  explicit TcpOp(std::vector<char> *any)
+      : data(nullptr), size(0), header(0), done(0), finished(false),
+        any(any) {}
+
+  // called when header of a recv is read
+  void on_header() {
+    if (any == nullptr) {
+      PADDLE_ENFORCE_EQ(header, size,
+                        "Received size mismatches expected size.");
+      return;
+    }
+    auto offset = any->size();
+    any->resize(offset + header);
+    data = any->data() + offset;
+    size = header;
+  }
+
+  char *data;
+  size_t size;
+  uint64_t header;
+  // bytes transferred, including header
+  size_t done;
+  bool finished;
+  std::vector<char> *any;
+};
+
+// completion handle of a TcpOp, waiting on any handle drives all
+// pending ops of the network, so that pairwise exchanges of payloads
+// larger than socket buffers do not deadlock
+class TcpHandle : public AsyncHandle {
+public:
+  TcpHandle(MeshNetworkTcp *net, std::shared_ptr<TcpOp> op)
+      : _net(net), _op(std::move(op)) {}
+
+  ~TcpHandle() {
+    try {
+      wait();
+    } catch (...) {
+      // op must not be released while socket may touch its buffer
+    }
+  }
+
+  void wait() override;
+
+private:
+  MeshNetworkTcp *_net;
+  std::shared_ptr<TcpOp> _op;
+};
+
+// A full-connected network over plain non-blocking tcp sockets.
+// endpoints are static, no rendezvous store is needed.
+// like other networks, it should be used by one thread.
+class MeshNetworkTcp : public paddle::mpc::AbstractNetwork {
+public:
+  // endpoints: "host0:port0;host1:port1;host2:port2", indexed by party id
+  // example:
+  // (in each party:)
+  //     paddle::mpc::MeshNetworkTcp net(0, 3, endpoints);
+  //     net.init();
+  //     net.send(1, data, sizeof(data))
+  MeshNetworkTcp(const size_t party_id, const size_t net_size,
+                 const std::string &endpoints)
+      : _party_id(party_id), _net_size(net_size), _endpoints(endpoints),
+        _epoll_fd(-1), _is_initialized(false) {}
+
+  virtual ~MeshNetworkTcp();
+
+  void send(size_t party, const void *data, size_t size) override;
+
+  void recv(size_t party, void *data, size_t size) override;
+
+  std::shared_ptr<AsyncHandle> isend(size_t party, const void *data,
+                                     size_t size) override;
+
+  std::shared_ptr<AsyncHandle> irecv(size_t party, void *data,
+                                     size_t size) override;
+
+  // sizes are on wire, a message of any size is sent as is
+  std::shared_ptr<AsyncHandle> isend_any(size_t party, const void *data,
+                                         size_t size) override {
+    return isend(party, data, size);
+  }
+
+  void recv_any(size_t party, std::vector<char> &data) override;
+
+  size_t party_id() const override { return _party_id; };
+
+  size_t party_num() const override { return _net_size; };
+
+  // must be called before use
+  // listens on own endpoint, connects to parties with smaller id
+  // and accepts connections from parties with larger id
+  void init();
+
+  // block until op is finished
+  void wait(const std::shared_ptr<TcpOp> &op);
+
+  // socket buffer size for both directions
+  static const int SOCKET_BUFFER_SIZE = 4 << 20;
+
+  // seconds to wait for peers on init
+  static const int CONNECT_TIMEOUT = 100;
+
+private:
+  struct Peer {
+    int fd = -1;
+    // epoll events currently registered
+    uint32_t events = 0;
+    std::deque<std::shared_ptr<TcpOp>> sends;
+    std::deque<std::shared_ptr<TcpOp>> recvs;
+  };
+
+  // advance ops of all peers, block in epoll if none can make progress
+  void progress();
+
+  // return true if any bytes are transferred
+  bool advance_send(Peer &peer);
+
+  bool advance_recv(Peer &peer);
+
+  void enforce_party(size_t party);
+
+  const size_t _party_id;
+  const size_t _net_size;
+  const std::string _endpoints;
+
+  std::vector<Peer> _peers;
+  int _epoll_fd;
+
+  bool _is_initialized;
+};
+
+} // mpc
+} // paddle
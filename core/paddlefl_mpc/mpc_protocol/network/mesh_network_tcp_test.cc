@@ -0,0 +1,150 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "core/paddlefl_mpc/mpc_protocol/network/mesh_network_tcp.h"
+
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace paddle {
+namespace mpc {
+
+class NetworkTest : public ::testing::Test {
+public:
+  std::string _endpoints;
+
+  std::shared_ptr<AbstractNetwork> _p0;
+  std::shared_ptr<AbstractNetwork> _p1;
+  std::shared_ptr<AbstractNetwork> _p2;
+
+  NetworkTest()
+      : _endpoints("localhost:8920;localhost:8921;localhost:8922") {}
+
+  void SetUp() {
+    _p0 = std::make_shared<MeshNetworkTcp>(0, 3, _endpoints);
+    _p1 = std::make_shared<MeshNetworkTcp>(1, 3, _endpoints);
+    _p2 = std::make_shared<MeshNetworkTcp>(2, 3, _endpoints);
+
+    std::thread t0([this]() { _p0->init(); });
+    std::thread t1([this]() { _p1->init(); });
+    std::thread t2([this]() { _p2->init(); });
+
+    t0.join();
+    t1.join();
+    t2.join();
+  }
+};
+
+TEST_F(NetworkTest, basic_test) {
+  int buf[3] = {0, 1, 2};
+  std::thread t0([this, &buf]() {
+    _p0->template send(1, buf[0]);
+    buf[0] = _p0->template recv<int>(2);
+  });
+
+  std::thread t1([this, &buf]() {
+    int to_send = buf[1];
+    buf[1] = _p1->template recv<int>(0);
+    _p1->template send(2, to_send);
+  });
+
+  std::thread t2([this, &buf]() {
+    int to_send = buf[2];
+    buf[2] = _p2->template recv<int>(1);
+    _p2->template send(0, to_send);
+  });
+
+  t0.join();
+  t1.join();
+  t2.join();
+
+  EXPECT_EQ(2, buf[0]);
+  EXPECT_EQ(0, buf[1]);
+  EXPECT_EQ(1, buf[2]);
+}
+
+TEST_F(NetworkTest, large_send_recv_test) {
+  // payload much larger than socket buffers
+  const size_t num = 16 << 20;
+  std::vector<char> in0(num, 'a');
+  std::vector<char> in1(num, 'b');
+  std::vector<char> out0(num);
+  std::vector<char> out1(num);
+
+  std::thread t0([&]() {
+    _p0->send_recv(1, in0.data(), num, 1, out0.data(), num);
+  });
+
+  std::thread t1([&]() {
+    _p1->send_recv(0, in1.data(), num, 0, out1.data(), num);
+  });
+  t0.join();
+  t1.join();
+
+  EXPECT_EQ(in1, out0);
+  EXPECT_EQ(in0, out1);
+}
+
+TEST_F(NetworkTest, ordered_burst_test) {
+  const int num = 1000;
+  std::vector<int> received(num, -1);
+  std::thread t0([this, num]() {
+    for (int i = 0; i < num; ++i) {
+      _p0->template send(2, i);
+    }
+  });
+
+  std::thread t2([this, num, &received]() {
+    for (int i = 0; i < num; ++i) {
+      received[i] = _p2->template recv<int>(0);
+    }
+  });
+
+  t0.join();
+  t2.join();
+
+  for (int i = 0; i < num; ++i) {
+    EXPECT_EQ(i, received[i]);
+  }
+}
+
+TEST_F(NetworkTest, send_any_test) {
+  // small and larger than socket buffers
+  const size_t sizes[] = {3, 16 << 20};
+  std::thread t0([&]() {
+    for (size_t size : sizes) {
+      std::vector<char> in(size, 'a');
+      _p0->isend_any(1, in.data(), in.size())->wait();
+    }
+  });
+
+  std::vector<char> out(1, 'b');
+  std::thread t1([&]() {
+    for (size_t i = 0; i < 2; ++i) {
+      _p1->recv_any(0, out);
+    }
+  });
+  t0.join();
+  t1.join();
+
+  // payloads are appended
+  std::vector<char> expect(1 + 3 + (16 << 20), 'a');
+  expect[0] = 'b';
+  EXPECT_EQ(expect, out);
+}
+
+} // namespace mpc
+} // namespace paddle
@@ -69,5 +69,66 @@ TEST_F(NetworkTest, basic_test) {
   EXPECT_EQ(0, buf[1]);
 }
 
+TEST_F(NetworkTest, async_test) {
+  int buf[2] = {0, 1};
+  int recv_buf[2] = {-1, -1};
+  std::thread t0([this, &buf, &recv_buf]() {
+    auto send_handle = _p0->isend(1, &buf[0], sizeof(int));
+    auto recv_handle = _p0->irecv(1, &recv_buf[0], sizeof(int));
+    recv_handle->wait();
+    send_handle->wait();
+  });
+
+  std::thread t1([this, &buf, &recv_buf]() {
+    auto send_handle = _p1->isend(0, &buf[1], sizeof(int));
+    auto recv_handle = _p1->irecv(0, &recv_buf[1], sizeof(int));
+    send_handle->wait();
+    recv_handle->wait();
+  });
+  t0.join();
+  t1.join();
+
+  EXPECT_EQ(1, recv_buf[0]);
+  EXPECT_EQ(0, recv_buf[1]);
+}
+
+TEST_F(NetworkTest, send_recv_test) {
+  int buf[2] = {0, 1};
+  std::thread t0([this, &buf]() {
+    buf[0] = _p0->template send_recv(1, buf[0], 1);
+  });
+
+  std::thread t1([this, &buf]() {
+    buf[1] = _p1->template send_recv(0, buf[1], 0);
+  });
+  t0.join();
+  t1.join();
+
+  EXPECT_EQ(1, buf[0]);
+  EXPECT_EQ(0, buf[1]);
+}
+
+TEST_F(NetworkTest, channel_test) {
+  auto c0 = _p0->channel(1);
+  auto c1 = _p1->channel(1);
+
+  // recv on channel is not matched by send on network
+  int buf[2] = {0, 1};
+  std::thread t0([this, &c0, &buf]() {
+    auto handle = c0->irecv(1, &buf[0], sizeof(int));
+    _p0->template send(1, 2);
+    handle->wait();
+  });
+
+  std::thread t1([this, &c1, &buf]() {
+    int from_net = _p1->template recv<int>(0);
+    c1->template send(0, buf[1] + from_net);
+  });
+  t0.join();
+  t1.join();
+
+  EXPECT_EQ(3, buf[0]);
+}
+
 } // namespace mpc
 } // namespace paddle
@@ -0,0 +1,99 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "metered_network.h"
+
+#include <chrono>
+
+#include "core/paddlefl_mpc/mpc_protocol/comm_stats.h"
+#include "core/paddlefl_mpc/mpc_protocol/context_holder.h"
+
+namespace paddle {
+namespace mpc {
+
+void MeteredRecvHandle::wait() {
+  if (_is_done) {
+    return;
+  }
+  _is_done = true;
+
+  auto begin = std::chrono::steady_clock::now();
+  _handle->wait();
+  auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - begin);
+  CommStats::record_recv_wait(_op_type, _party, elapsed.count());
+}
+
+void MeteredNetwork::on_send(const std::string &op_type, size_t party,
+                             size_t size) {
+  CommStats::record_send(op_type, party, size);
+  _last_is_recv = false;
+}
+
+void MeteredNetwork::on_recv(const std::string &op_type, size_t party,
+                             size_t size) {
+  CommStats::record_recv(op_type, party, size);
+  if (!_last_is_recv) {
+    CommStats::record_round(op_type);
+  }
+  _last_is_recv = true;
+}
+
+void MeteredNetwork::send(size_t party, const void *data, size_t size) {
+  on_send(ContextHolder::op_type(), party, size);
+  _network->send(party, data, size);
+}
+
+void MeteredNetwork::recv(size_t party, void *data, size_t size) {
+  irecv(party, data, size)->wait();
+}
+
+std::shared_ptr<AsyncHandle> MeteredNetwork::isend(size_t party,
+                                                   const void *data,
+                                                   size_t size) {
+  on_send(ContextHolder::op_type(), party, size);
+  return _network->isend(party, data, size);
+}
+
+std::shared_ptr<AsyncHandle> MeteredNetwork::irecv(size_t party, void *data,
+                                                   size_t size) {
+  const auto &op_type = ContextHolder::op_type();
+  on_recv(op_type, party, size);
+  return std::make_shared<MeteredRecvHandle>(
+      _network->irecv(party, data, size), op_type, party);
+}
+
+std::shared_ptr<AsyncHandle> MeteredNetwork::isend_any(size_t party,
+                                                       const void *data,
+                                                       size_t size) {
+  on_send(ContextHolder::op_type(), party, size);
+  return _network->isend_any(party, data, size);
+}
+
+void MeteredNetwork::recv_any(size_t party, std::vector<char> &data) {
+  const auto &op_type = ContextHolder::op_type();
+  auto offset = data.size();
+
+  auto begin = std::chrono::steady_clock::now();
+  _network->recv_any(party, data);
+  auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - begin);
+
+  // size is known once received
+  on_recv(op_type, party, data.size() - offset);
+  CommStats::record_recv_wait(op_type, party, elapsed.count());
+}
+
+} // mpc
+} // paddle
@@ -0,0 +1,94 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/paddlefl_mpc/mpc_protocol/abstract_network.h"
+
+namespace paddle {
+namespace mpc {
+
+// measures time blocked in wait() of a recv handle
+class MeteredRecvHandle : public AsyncHandle {
+public:
+  MeteredRecvHandle(std::shared_ptr<AsyncHandle> handle,
+                    const std::string &op_type, size_t party)
+      : _handle(std::move(handle)), _op_type(op_type), _party(party),
+        _is_done(false) {}
+
+  void wait() override;
+
+private:
+  std::shared_ptr<AsyncHandle> _handle;
+  const std::string _op_type;
+  const size_t _party;
+  bool _is_done;
+};
+
+// A decorator counting traffic of the underlying network into CommStats.
+// traffic is attributed to the op type in ContextHolder at the time
+// the send or recv is issued.
+class MeteredNetwork : public paddle::mpc::AbstractNetwork {
+public:
+  explicit MeteredNetwork(std::shared_ptr<AbstractNetwork> network)
+      : _network(std::move(network)), _last_is_recv(false) {}
+
+  virtual ~MeteredNetwork() = default;
+
+  void send(size_t party, const void *data, size_t size) override;
+
+  void recv(size_t party, void *data, size_t size) override;
+
+  std::shared_ptr<AsyncHandle> isend(size_t party, const void *data,
+                                     size_t size) override;
+
+  std::shared_ptr<AsyncHandle> irecv(size_t party, void *data,
+                                     size_t size) override;
+
+  std::shared_ptr<AsyncHandle> isend_any(size_t party, const void *data,
+                                         size_t size) override;
+
+  void recv_any(size_t party, std::vector<char> &data) override;
+
+  size_t party_id() const override { return _network->party_id(); };
+
+  size_t party_num() const override { return _network->party_num(); };
+
+  void init() override { _network->init(); }
+
+  void flush() override { _network->flush(); }
+
+  // traffic of channels is counted as well
+  std::shared_ptr<AbstractNetwork> channel(size_t id) override {
+    return std::make_shared<MeteredNetwork>(_network->channel(id));
+  }
+
+  std::shared_ptr<AbstractNetwork> network() const { return _network; }
+
+private:
+  void on_send(const std::string &op_type, size_t party, size_t size);
+
+  void on_recv(const std::string &op_type, size_t party, size_t size);
+
+  std::shared_ptr<AbstractNetwork> _network;
+  // a recv issued after a send starts a new round
+  bool _last_is_recv;
+};
+
+} // mpc
+} // paddle
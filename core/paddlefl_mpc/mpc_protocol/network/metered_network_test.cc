@@ -0,0 +1,132 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "core/paddlefl_mpc/mpc_protocol/network/metered_network.h"
+
+#include <thread>
+
+#include "gtest/gtest.h"
+#include "paddle/fluid/framework/operator.h"
+#include "paddle/fluid/framework/scope.h"
+
+#include "core/paddlefl_mpc/mpc_protocol/comm_stats.h"
+#include "core/paddlefl_mpc/mpc_protocol/context_holder.h"
+#include "core/paddlefl_mpc/mpc_protocol/network/mesh_network_shm.h"
+
+namespace paddle {
+namespace mpc {
+
+class MeteredNetworkTest : public ::testing::Test {
+public:
+  paddle::platform::CPUDeviceContext _cpu_ctx;
+  std::shared_ptr<paddle::framework::ExecutionContext> _exec_ctx;
+
+  std::shared_ptr<AbstractNetwork> _p0;
+  std::shared_ptr<AbstractNetwork> _p1;
+
+  void SetUp() {
+    paddle::framework::OperatorBase* op = nullptr;
+    paddle::framework::Scope scope;
+    paddle::framework::RuntimeContext ctx({}, {});
+    // only device_ctx is needed
+    _exec_ctx = std::make_shared<paddle::framework::ExecutionContext>(
+        *op, scope, _cpu_ctx, ctx);
+
+    _p0 = std::make_shared<MeteredNetwork>(
+        std::make_shared<MeshNetworkShm>(0, 2, "test_metered"));
+    _p1 = std::make_shared<MeteredNetwork>(
+        std::make_shared<MeshNetworkShm>(1, 2, "test_metered"));
+
+    std::thread t0([this]() { _p0->init(); });
+    std::thread t1([this]() { _p1->init(); });
+    t0.join();
+    t1.join();
+
+    CommStats::reset();
+  }
+};
+
+TEST_F(MeteredNetworkTest, op_attribution_test) {
+  // both parties live in this process, so their counters are
+  // recorded into same CommStats
+  std::thread t0([this]() {
+    ContextHolder::run_with_context(_exec_ctx.get(), nullptr, "op_a", [this]() {
+      int64_t buf[2] = {1, 2};
+      _p0->send(1, buf, sizeof(buf));
+      _p0->template recv<int>(1);
+    });
+    // traffic outside any op
+    _p0->template send(1, 0);
+  });
+
+  std::thread t1([this]() {
+    ContextHolder::run_with_context(_exec_ctx.get(), nullptr, "op_a", [this]() {
+      int64_t buf[2];
+      _p1->recv(0, buf, sizeof(buf));
+      _p1->template send(0, 3);
+    });
+    _p1->template recv<int>(0);
+  });
+  t0.join();
+  t1.join();
+
+  auto stats = CommStats::snapshot();
+  ASSERT_EQ(1u, stats.count("op_a"));
+  ASSERT_EQ(1u, stats.count(CommStats::UNATTRIBUTED));
+
+  // one recv phase for each party
+  EXPECT_EQ(2u, stats["op_a"].rounds);
+
+  auto& p0_to_p1 = stats["op_a"].peers[1];
+  EXPECT_EQ(16u, p0_to_p1.bytes_sent);
+  EXPECT_EQ(4u, p0_to_p1.bytes_recv);
+  EXPECT_EQ(1u, p0_to_p1.msgs_sent);
+  EXPECT_EQ(1u, p0_to_p1.msgs_recv);
+
+  auto& p1_to_p0 = stats["op_a"].peers[0];
+  EXPECT_EQ(4u, p1_to_p0.bytes_sent);
+  EXPECT_EQ(16u, p1_to_p0.bytes_recv);
+
+  EXPECT_EQ(4u, stats[CommStats::UNATTRIBUTED].peers[1].bytes_sent);
+  EXPECT_EQ(4u, stats[CommStats::UNATTRIBUTED].peers[0].bytes_recv);
+}
+
+TEST_F(MeteredNetworkTest, send_recv_round_test) {
+  std::thread t0([this]() {
+    ContextHolder::run_with_context(_exec_ctx.get(), nullptr, "op_b", [this]() {
+      for (int i = 0; i < 3; ++i) {
+        _p0->template send_recv(1, i, 1);
+      }
+    });
+  });
+
+  std::thread t1([this]() {
+    ContextHolder::run_with_context(_exec_ctx.get(), nullptr, "op_b", [this]() {
+      for (int i = 0; i < 3; ++i) {
+        _p1->template send_recv(0, i, 0);
+      }
+    });
+  });
+  t0.join();
+  t1.join();
+
+  auto stats = CommStats::snapshot();
+  // each send_recv is one round, for each of two parties
+  EXPECT_EQ(6u, stats["op_b"].rounds);
+  EXPECT_EQ(3u, stats["op_b"].peers[0].msgs_recv);
+  EXPECT_EQ(3u, stats["op_b"].peers[1].msgs_recv);
+}
+
+} // namespace mpc
+} // namespace paddle
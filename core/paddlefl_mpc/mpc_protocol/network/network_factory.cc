@@ -17,7 +17,12 @@
 #include "gloo/rendezvous/redis_store.h"
 #include "paddle/fluid/framework/tensor.h"
 
+#include "core/paddlefl_mpc/mpc_protocol/network/coalescing_network.h"
 #include "core/paddlefl_mpc/mpc_protocol/network/mesh_network.h"
+#include "core/paddlefl_mpc/mpc_protocol/network/metered_network.h"
+#include "core/paddlefl_mpc/mpc_protocol/network/mesh_network_shm.h"
+#include "core/paddlefl_mpc/mpc_protocol/network/mesh_network_tcp.h"
+#include "core/paddlefl_mpc/mpc_protocol/network/wan_network.h"
 
 #ifdef WTIH_GRPC
 #include "core/paddlefl_mpc/mpc_protocol/network/mesh_network_grpc.h"
@@ -45,6 +50,27 @@ void MpcNetworkFactory::register_creator() {
 
         _creator_map.insert({"gloo", gloo_net_creator});
 
+        auto tcp_net_creator = [](const MpcConfig &config) {
+            auto party_id = config.get_int(MpcConfig::ROLE);
+            auto net_size = config.get_int(MpcConfig::NET_SIZE);
+            auto endpoints = config.get(MpcConfig::ENDPOINTS, MpcConfig::ENDPOINTS_DEFAULT);
+
+            return std::make_shared<MeshNetworkTcp>(party_id, net_size, endpoints);
+        };
+
+        _creator_map.insert({"tcp", tcp_net_creator});
+
+        // parties on one host, name starting with '/' is shared by processes
+        auto shm_net_creator = [](const MpcConfig &config) {
+            auto party_id = config.get_int(MpcConfig::ROLE);
+            auto net_size = config.get_int(MpcConfig::NET_SIZE);
+            auto name = config.get(MpcConfig::NET_SHM_NAME, MpcConfig::NET_SHM_NAME_DEFAULT);
+
+            return std::make_shared<MeshNetworkShm>(party_id, net_size, name);
+        };
+
+        _creator_map.insert({"shm", shm_net_creator});
+
 #ifdef WTIH_GRPC
         auto grpc_net_creator = [](const MpcConfig &config) {
             auto party_id = config.get_int(MpcConfig::ROLE);
@@ -55,6 +81,19 @@ void MpcNetworkFactory::register_creator() {
         };
 
         _creator_map.insert({"grpc", grpc_net_creator});
+
+        auto grpc_stream_net_creator = [](const MpcConfig &config) {
+            auto party_id = config.get_int(MpcConfig::ROLE);
+            auto net_size = config.get_int(MpcConfig::NET_SIZE);
+            auto endpoints = config.get(MpcConfig::ENDPOINTS, MpcConfig::ENDPOINTS_DEFAULT);
+            auto queue_depth = config.get_int(MpcConfig::NET_QUEUE_DEPTH,
+                                              MpcConfig::NET_QUEUE_DEPTH_DEFAULT);
+
+            return std::make_shared<MeshNetworkGrpc>(party_id, net_size, endpoints,
+                                                     true, queue_depth);
+        };
+
+        _creator_map.insert({"grpc_stream", grpc_stream_net_creator});
 #endif
 
     }
@@ -65,7 +104,28 @@ MpcNetworkFactory::Creator MpcNetworkFactory::get_creator(const std::string &nam
     if (!_is_initialized) {
         register_creator();
     }
-    return _creator_map[to_lowercase(name)];
+    auto creator = _creator_map[to_lowercase(name)];
+    if (!creator) {
+        return creator;
+    }
+    // coalesce sends, emulate wan links and count traffic into
+    // CommStats if required
+    return [creator](const MpcConfig &config) {
+        auto net = creator(config);
+        if (config.get_int(MpcConfig::NET_COALESCE, 0) != 0) {
+            net = std::make_shared<CoalescingNetwork>(net);
+        }
+        if (!config.get(MpcConfig::NET_WAN_LATENCY_US).empty()
+            || !config.get(MpcConfig::NET_WAN_BANDWIDTH_MBPS).empty()
+            || !config.get(MpcConfig::NET_WAN_LINKS).empty()) {
+            auto net_size = config.get_int(MpcConfig::NET_SIZE);
+            net = WanNetwork::from_config(net, net_size, config);
+        }
+        if (config.get_int(MpcConfig::NET_METERED, 0) != 0) {
+            net = std::make_shared<MeteredNetwork>(net);
+        }
+        return net;
+    };
 }
 
 MpcNetworkFactory::CreatorMap MpcNetworkFactory::_creator_map;
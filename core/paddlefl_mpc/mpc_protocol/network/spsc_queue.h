@@ -0,0 +1,123 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Description:
+// bounded lock-free single-producer single-consumer queue
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "paddle/fluid/platform/enforce.h"
+
+namespace paddle {
+namespace mpc {
+
+// wait strategy of spsc endpoints: spin first, then yield, then sleep,
+// so that a short wait costs no syscall and a long one costs no cpu
+inline void spsc_backoff(size_t round) {
+    static const size_t SPIN_ROUND = 64;
+    static const size_t YIELD_ROUND = 1024;
+    if (round < SPIN_ROUND) {
+        return;
+    } else if (round < YIELD_ROUND) {
+        std::this_thread::yield();
+    } else {
+        std::this_thread::sleep_for(std::chrono::microseconds(20));
+    }
+}
+
+// exactly one thread may push and exactly one thread may pop
+template <typename T>
+class SpscQueue {
+public:
+    explicit SpscQueue(size_t depth)
+        : _slots(depth + 1), _head(0), _tail(0), _closed(false) {
+        PADDLE_ENFORCE_GT(depth, 0, "Queue depth should be positive.");
+    }
+
+    SpscQueue(const SpscQueue& other) = delete;
+
+    SpscQueue& operator=(const SpscQueue& other) = delete;
+
+    // value is moved only if true is returned
+    bool try_push(T&& value) {
+        size_t tail = _tail.load(std::memory_order_relaxed);
+        size_t next = advance(tail);
+        if (next == _head.load(std::memory_order_acquire)) {
+            return false;
+        }
+        _slots[tail] = std::move(value);
+        _tail.store(next, std::memory_order_release);
+        return true;
+    }
+
+    bool try_pop(T& value) {
+        size_t head = _head.load(std::memory_order_relaxed);
+        if (head == _tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        value = std::move(_slots[head]);
+        _head.store(advance(head), std::memory_order_release);
+        return true;
+    }
+
+    // block until pushed, false is returned if queue is closed meanwhile
+    bool push(T&& value) {
+        for (size_t round = 0; !try_push(std::move(value)); ++round) {
+            if (_closed.load(std::memory_order_relaxed)) {
+                return false;
+            }
+            spsc_backoff(round);
+        }
+        return true;
+    }
+
+    // block until popped, false is returned if queue is closed meanwhile
+    bool pop(T& value) {
+        for (size_t round = 0; !try_pop(value); ++round) {
+            if (_closed.load(std::memory_order_relaxed)) {
+                return false;
+            }
+            spsc_backoff(round);
+        }
+        return true;
+    }
+
+    // wake up blocked push and pop, called on shutdown
+    void close() {
+        _closed.store(true, std::memory_order_relaxed);
+    }
+
+    size_t depth() const {
+        return _slots.size() - 1;
+    }
+
+private:
+    size_t advance(size_t idx) const {
+        return idx + 1 == _slots.size() ? 0 : idx + 1;
+    }
+
+    std::vector<T> _slots;
+    // producer and consumer indices live on separate cache lines
+    alignas(64) std::atomic<size_t> _head;
+    alignas(64) std::atomic<size_t> _tail;
+    std::atomic<bool> _closed;
+};
+
+} // mpc
+} // paddle
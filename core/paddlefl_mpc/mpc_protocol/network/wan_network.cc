@@ -0,0 +1,167 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "wan_network.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <sstream>
+
+#include "paddle/fluid/platform/enforce.h"
+
+namespace paddle {
+namespace mpc {
+
+void WanRecvHandle::wait() {
+  if (_is_done) {
+    return;
+  }
+  _is_done = true;
+  _header_handle->wait();
+  _data_handle->wait();
+  _net->on_arrival(_party, *_arrival);
+}
+
+WanNetwork::WanNetwork(std::shared_ptr<AbstractNetwork> network,
+                       std::vector<WanLink> links, uint64_t seed,
+                       bool count_compute)
+    : _network(std::move(network)), _links(std::move(links)), _seed(seed),
+      _count_compute(count_compute), _clock_ns(0),
+      _link_free_ns(_network->party_num(), 0),
+      _last_arrival_ns(_network->party_num(), 0),
+      // each party draws different jitter from same seed
+      _rng(seed * 3 + _network->party_id()) {
+  PADDLE_ENFORCE_EQ(_links.size(), party_num() * party_num(),
+                    "Num of links should be net_size * net_size.");
+}
+
+std::shared_ptr<WanNetwork>
+WanNetwork::from_config(std::shared_ptr<AbstractNetwork> network,
+                        size_t net_size, const MpcConfig &config) {
+  WanLink default_link;
+  default_link.latency_us = config.get_int(MpcConfig::NET_WAN_LATENCY_US, 0);
+  default_link.bandwidth_mbps =
+      config.get_int(MpcConfig::NET_WAN_BANDWIDTH_MBPS, 0);
+  default_link.jitter_us = config.get_int(MpcConfig::NET_WAN_JITTER_US, 0);
+  std::vector<WanLink> links(net_size * net_size, default_link);
+
+  // per-link overrides, "from-to:latency_us:bandwidth_mbps:jitter_us;..."
+  std::stringstream specs(config.get(MpcConfig::NET_WAN_LINKS));
+  std::string spec;
+  while (std::getline(specs, spec, ';')) {
+    if (spec.find_first_not_of(" ") == std::string::npos) {
+      continue;
+    }
+    size_t from = 0;
+    size_t to = 0;
+    unsigned long long latency = 0;
+    unsigned long long bandwidth = 0;
+    unsigned long long jitter = 0;
+    int num = sscanf(spec.c_str(), " %zu-%zu:%llu:%llu:%llu", &from, &to,
+                     &latency, &bandwidth, &jitter);
+    PADDLE_ENFORCE_GE(num, 3, "Invalid wan link spec: %s.", spec);
+    PADDLE_ENFORCE(from < net_size && to < net_size,
+                   "Invalid party in wan link spec: %s.", spec);
+    auto &link = links[from * net_size + to];
+    link.latency_us = latency;
+    link.bandwidth_mbps = num > 3 ? bandwidth : default_link.bandwidth_mbps;
+    link.jitter_us = num > 4 ? jitter : default_link.jitter_us;
+  }
+
+  return std::make_shared<WanNetwork>(
+      network, links, config.get_int(MpcConfig::NET_WAN_SEED, 0),
+      config.get_int(MpcConfig::NET_WAN_COUNT_COMPUTE, 0) != 0);
+}
+
+void WanNetwork::init() {
+  _network->init();
+  _last_call = std::chrono::steady_clock::now();
+}
+
+std::shared_ptr<AbstractNetwork> WanNetwork::channel(size_t id) {
+  auto net = std::make_shared<WanNetwork>(_network->channel(id), _links,
+                                          _seed + id, _count_compute);
+  net->_last_call = std::chrono::steady_clock::now();
+  return net;
+}
+
+void WanNetwork::count_compute() {
+  if (!_count_compute) {
+    return;
+  }
+  auto now = std::chrono::steady_clock::now();
+  _clock_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   now - _last_call).count();
+  _last_call = now;
+}
+
+uint64_t WanNetwork::schedule(size_t party, size_t size) {
+  const auto &l = link(party_id(), party);
+
+  // messages on a link are serialized one after another
+  uint64_t depart = std::max(_clock_ns, _link_free_ns[party]);
+  if (l.bandwidth_mbps > 0) {
+    // bits / (mbps * 1e6) seconds, in ns
+    depart += size * 8 * 1000 / l.bandwidth_mbps;
+  }
+  _link_free_ns[party] = depart;
+
+  uint64_t jitter = 0;
+  if (l.jitter_us > 0) {
+    jitter = std::uniform_int_distribution<uint64_t>(0, l.jitter_us)(_rng);
+  }
+  uint64_t arrival = depart + (l.latency_us + jitter) * 1000;
+  // no reordering on a link, as with tcp
+  arrival = std::max(arrival, _last_arrival_ns[party]);
+  _last_arrival_ns[party] = arrival;
+  return arrival;
+}
+
+void WanNetwork::on_arrival(size_t party, uint64_t arrival_ns) {
+  _clock_ns = std::max(_clock_ns, arrival_ns);
+  if (_count_compute) {
+    _last_call = std::chrono::steady_clock::now();
+  }
+}
+
+void WanNetwork::send(size_t party, const void *data, size_t size) {
+  isend(party, data, size)->wait();
+}
+
+void WanNetwork::recv(size_t party, void *data, size_t size) {
+  irecv(party, data, size)->wait();
+}
+
+std::shared_ptr<AsyncHandle> WanNetwork::isend(size_t party,
+                                               const void *data,
+                                               size_t size) {
+  count_compute();
+  auto arrival = std::make_shared<uint64_t>(schedule(party, size));
+  auto header_handle = _network->isend(party, arrival.get(), sizeof(uint64_t));
+  auto data_handle = _network->isend(party, data, size);
+  return std::make_shared<WanSendHandle>(arrival, header_handle, data_handle);
+}
+
+std::shared_ptr<AsyncHandle> WanNetwork::irecv(size_t party, void *data,
+                                               size_t size) {
+  count_compute();
+  auto arrival = std::make_shared<uint64_t>(0);
+  auto header_handle = _network->irecv(party, arrival.get(), sizeof(uint64_t));
+  auto data_handle = _network->irecv(party, data, size);
+  return std::make_shared<WanRecvHandle>(this, party, arrival, header_handle,
+                                         data_handle);
+}
+
+} // mpc
+} // paddle
@@ -0,0 +1,161 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "core/paddlefl_mpc/mpc_protocol/abstract_network.h"
+#include "core/paddlefl_mpc/mpc_protocol/mpc_config.h"
+
+namespace paddle {
+namespace mpc {
+
+// emulated property of a directed link
+struct WanLink {
+  // one-way latency
+  uint64_t latency_us = 0;
+  // 0 for unlimited
+  uint64_t bandwidth_mbps = 0;
+  // extra latency uniformly drawn from [0, jitter_us]
+  uint64_t jitter_us = 0;
+};
+
+class WanNetwork;
+
+// completion handle of a recv, which advances the virtual clock
+// to the arrival time of the message
+class WanRecvHandle : public AsyncHandle {
+public:
+  WanRecvHandle(WanNetwork *net, size_t party,
+                std::shared_ptr<uint64_t> arrival,
+                std::shared_ptr<AsyncHandle> header_handle,
+                std::shared_ptr<AsyncHandle> data_handle)
+      : _net(net), _party(party), _arrival(std::move(arrival)),
+        _header_handle(std::move(header_handle)),
+        _data_handle(std::move(data_handle)), _is_done(false) {}
+
+  void wait() override;
+
+private:
+  WanNetwork *_net;
+  const size_t _party;
+  std::shared_ptr<uint64_t> _arrival;
+  std::shared_ptr<AsyncHandle> _header_handle;
+  std::shared_ptr<AsyncHandle> _data_handle;
+  bool _is_done;
+};
+
+class WanSendHandle : public AsyncHandle {
+public:
+  WanSendHandle(std::shared_ptr<uint64_t> arrival,
+                std::shared_ptr<AsyncHandle> header_handle,
+                std::shared_ptr<AsyncHandle> data_handle)
+      : _arrival(std::move(arrival)),
+        _header_handle(std::move(header_handle)),
+        _data_handle(std::move(data_handle)) {}
+
+  void wait() override {
+    _header_handle->wait();
+    _data_handle->wait();
+  }
+
+private:
+  // sent by _header_handle, must outlive it
+  std::shared_ptr<uint64_t> _arrival;
+  std::shared_ptr<AsyncHandle> _header_handle;
+  std::shared_ptr<AsyncHandle> _data_handle;
+};
+
+// A wrapper emulating wan links over the underlying network with a
+// virtual clock. every message carries its virtual arrival time,
+// computed by sender from latency, bandwidth and jitter of the link,
+// and a recv moves the receiver's clock forward to it. so the virtual
+// time is deterministic and free of the real network's cost.
+class WanNetwork : public paddle::mpc::AbstractNetwork {
+public:
+  // links: net_size * net_size links, links[i * net_size + j] is the
+  // link from party i to party j
+  // count_compute: if true, real time elapsed between network calls
+  // is added to the clock, so the clock estimates end-to-end time
+  // but is no longer deterministic
+  WanNetwork(std::shared_ptr<AbstractNetwork> network,
+             std::vector<WanLink> links, uint64_t seed = 0,
+             bool count_compute = false);
+
+  virtual ~WanNetwork() = default;
+
+  // build from MpcConfig::NET_WAN_* items
+  static std::shared_ptr<WanNetwork>
+  from_config(std::shared_ptr<AbstractNetwork> network, size_t net_size,
+              const MpcConfig &config);
+
+  void send(size_t party, const void *data, size_t size) override;
+
+  void recv(size_t party, void *data, size_t size) override;
+
+  std::shared_ptr<AsyncHandle> isend(size_t party, const void *data,
+                                     size_t size) override;
+
+  std::shared_ptr<AsyncHandle> irecv(size_t party, void *data,
+                                     size_t size) override;
+
+  size_t party_id() const override { return _network->party_id(); };
+
+  size_t party_num() const override { return _network->party_num(); };
+
+  void init() override;
+
+  void flush() override { _network->flush(); }
+
+  // a channel emulates the same links with its own clock
+  std::shared_ptr<AbstractNetwork> channel(size_t id) override;
+
+  // virtual time of this party since init, in microseconds
+  uint64_t virtual_time_us() const { return _clock_ns / 1000; }
+
+  // called by WanRecvHandle
+  void on_arrival(size_t party, uint64_t arrival_ns);
+
+private:
+  const WanLink &link(size_t from, size_t to) const {
+    return _links[from * party_num() + to];
+  }
+
+  // arrival time of a message of size bytes to be sent to party now
+  uint64_t schedule(size_t party, size_t size);
+
+  void count_compute();
+
+  std::shared_ptr<AbstractNetwork> _network;
+  const std::vector<WanLink> _links;
+  const uint64_t _seed;
+  const bool _count_compute;
+
+  uint64_t _clock_ns;
+  // time each outgoing link finishes serializing queued messages
+  std::vector<uint64_t> _link_free_ns;
+  // last arrival of each outgoing link, keeps messages in order
+  std::vector<uint64_t> _last_arrival_ns;
+  std::mt19937_64 _rng;
+  std::chrono::steady_clock::time_point _last_call;
+};
+
+} // mpc
+} // paddle
@@ -0,0 +1,125 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "core/paddlefl_mpc/mpc_protocol/network/wan_network.h"
+
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "core/paddlefl_mpc/mpc_protocol/network/mesh_network_shm.h"
+
+namespace paddle {
+namespace mpc {
+
+class WanNetworkTest : public ::testing::Test {
+public:
+  std::shared_ptr<WanNetwork> _p0;
+  std::shared_ptr<WanNetwork> _p1;
+
+  // latency 10ms, 8 Mbps (1 byte per us) from 0 to 1,
+  // latency 5ms, unlimited bandwidth from 1 to 0
+  void SetUp() {
+    MpcConfig config;
+    config.set(MpcConfig::NET_WAN_LINKS, "0-1:10000:8;1-0:5000:0");
+
+    _p0 = WanNetwork::from_config(
+        std::make_shared<MeshNetworkShm>(0, 2, "test_wan"), 2, config);
+    _p1 = WanNetwork::from_config(
+        std::make_shared<MeshNetworkShm>(1, 2, "test_wan"), 2, config);
+
+    std::thread t0([this]() { _p0->init(); });
+    std::thread t1([this]() { _p1->init(); });
+    t0.join();
+    t1.join();
+  }
+};
+
+TEST_F(WanNetworkTest, ping_pong_test) {
+  std::thread t0([this]() {
+    _p0->AbstractNetwork::template send(1, 0);
+    EXPECT_EQ(1, _p0->AbstractNetwork::template recv<int>(1));
+  });
+
+  std::thread t1([this]() {
+    EXPECT_EQ(0, _p1->AbstractNetwork::template recv<int>(0));
+    _p1->AbstractNetwork::template send(0, 1);
+  });
+  t0.join();
+  t1.join();
+
+  // 4 bytes serialized in 4us, then 10ms latency
+  EXPECT_EQ(10004u, _p1->virtual_time_us());
+  EXPECT_EQ(15004u, _p0->virtual_time_us());
+}
+
+TEST_F(WanNetworkTest, bandwidth_test) {
+  const size_t num = 10000;
+  std::vector<char> buf(num);
+  std::thread t0([&]() {
+    // messages queue on the link
+    _p0->send(1, buf.data(), num);
+    _p0->send(1, buf.data(), num);
+  });
+
+  std::thread t1([&]() {
+    std::vector<char> out(num);
+    _p1->recv(0, out.data(), num);
+    EXPECT_EQ(20000u, _p1->virtual_time_us());
+    _p1->recv(0, out.data(), num);
+    EXPECT_EQ(30000u, _p1->virtual_time_us());
+  });
+  t0.join();
+  t1.join();
+}
+
+TEST(WanNetworkConfigTest, jitter_is_deterministic_test) {
+  std::vector<uint64_t> times;
+  for (int run = 0; run < 2; ++run) {
+    MpcConfig config;
+    config.set_int(MpcConfig::NET_WAN_LATENCY_US, 1000);
+    config.set_int(MpcConfig::NET_WAN_JITTER_US, 500);
+    config.set_int(MpcConfig::NET_WAN_SEED, 7);
+    auto p0 = WanNetwork::from_config(
+        std::make_shared<MeshNetworkShm>(0, 2, "test_wan_jitter"), 2, config);
+    auto p1 = WanNetwork::from_config(
+        std::make_shared<MeshNetworkShm>(1, 2, "test_wan_jitter"), 2, config);
+
+    std::thread t0([&]() {
+      p0->init();
+      for (int i = 0; i < 10; ++i) {
+        p0->AbstractNetwork::template send(1, i);
+        p0->AbstractNetwork::template recv<int>(1);
+      }
+    });
+    std::thread t1([&]() {
+      p1->init();
+      for (int i = 0; i < 10; ++i) {
+        p1->AbstractNetwork::template recv<int>(0);
+        p1->AbstractNetwork::template send(0, i);
+      }
+    });
+    t0.join();
+    t1.join();
+
+    EXPECT_GE(p0->virtual_time_us(), 20000u);
+    EXPECT_LE(p0->virtual_time_us(), 30000u);
+    times.emplace_back(p0->virtual_time_us());
+  }
+  EXPECT_EQ(times[0], times[1]);
+}
+
+} // namespace mpc
+} // namespace paddle
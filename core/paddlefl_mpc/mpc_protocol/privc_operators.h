@@ -124,14 +124,16 @@ public:
         op_f.sigmoid(&out_f);
     }
 
-    void softmax(const Tensor *op, Tensor *out, bool use_relu, bool use_long_div) override {
+    // privc has no goldschmidt_div, use_goldschmidt_div is ignored
+    void softmax(const Tensor *op, Tensor *out, bool use_relu, bool use_long_div,
+                 bool use_goldschmidt_div, bool use_split_exp) override {
         PaddleTensor op_(device_ctx(), *op);
         PaddleTensor out_(device_ctx(), *out);
 
         PrivCFixedTensor op_f(&op_);
         PrivCFixedTensor out_f(&out_);
 
-        op_f.softmax(&out_f, use_relu);
+        op_f.softmax(&out_f, use_relu, use_split_exp);
     }
 
     void argmax(const Tensor *op, Tensor *out) override {
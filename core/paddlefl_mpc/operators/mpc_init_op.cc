@@ -39,6 +39,9 @@ public:
         auto net_server_port = Attr<int>("net_server_port");
         auto endpoints = Attr<std::string>("endpoints");
         auto network_mode = Attr<std::string>("network_mode");
+        auto enable_comm_stats = Attr<bool>("enable_comm_stats");
+        auto coalesce_sends = Attr<bool>("coalesce_sends");
+        auto preprocessing_file = Attr<std::string>("preprocessing_file");
 
         MpcConfig _mpc_config;
         _mpc_config.set_int(MpcConfig::ROLE, role);
@@ -47,6 +50,9 @@ public:
         _mpc_config.set_int(MpcConfig::NET_SERVER_PORT, net_server_port);
         _mpc_config.set(MpcConfig::ENDPOINTS, endpoints);
         _mpc_config.set(MpcConfig::NETWORK_MODE, network_mode);
+        _mpc_config.set_int(MpcConfig::NET_METERED, enable_comm_stats);
+        _mpc_config.set_int(MpcConfig::NET_COALESCE, coalesce_sends);
+        _mpc_config.set(MpcConfig::PREPROCESSING_FILE, preprocessing_file);
         mpc::MpcInstance::init_instance(_mpc_config);
     }
 };
@@ -80,6 +86,19 @@ Mpc Init Operator.
                                       "(string, default gloo)"
                                       "network_mode")
         .SetDefault({"gloo"});
+        AddAttr<bool>("enable_comm_stats",
+                      "(bool, default false)"
+                      "count traffic of each op, see mpc_data_utils.comm_stats")
+        .SetDefault(false);
+        AddAttr<bool>("coalesce_sends",
+                      "(bool, default false)"
+                      "batch small msgs to a peer until next recv")
+        .SetDefault(false);
+        AddAttr<std::string>("preprocessing_file",
+                             "(string, default empty)"
+                             "load preprocessed randomness of party i from"
+                             " file '<preprocessing_file>.i'")
+        .SetDefault({""});
     }
 };
 
@@ -32,9 +32,21 @@ public:
         PADDLE_ENFORCE_NOT_NULL(mpc::MpcInstance::mpc_instance()->mpc_protocol(),
                                 "Mpc protocol is not yet initialized in executor");
 
-        std::shared_ptr<mpc::AbstractContext> mpc_ctx(mpc::MpcInstance::mpc_instance()->mpc_protocol()->mpc_context());
+        auto protocol = mpc::MpcInstance::mpc_instance()->mpc_protocol();
+        // ops with attr mpc_channel run on their own network channel
+        std::shared_ptr<mpc::AbstractContext> mpc_ctx;
+        if (ctx.HasAttr("mpc_channel")) {
+            int channel = ctx.Attr<int>("mpc_channel");
+            PADDLE_ENFORCE_GE(channel, 0,
+                              platform::errors::InvalidArgument(
+                                  "mpc_channel should be non-negative, "
+                                  "but received %d", channel));
+            mpc_ctx = protocol->channel_context(static_cast<size_t>(channel));
+        } else {
+            mpc_ctx = protocol->mpc_context();
+        }
         mpc::ContextHolder::template run_with_context<>(&ctx, mpc_ctx,
-                [&] { ComputeImpl(ctx); });
+                ctx.GetOp().Type(), [&] { ComputeImpl(ctx); });
     }
     virtual void ComputeImpl(const framework::ExecutionContext& ctx) const = 0;
 };
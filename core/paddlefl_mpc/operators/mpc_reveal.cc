@@ -28,25 +28,35 @@ class MpcRevealOp : public framework::OperatorWithKernel {
       : OperatorWithKernel(type, inputs, outputs, attrs) {}
 
   void InferShape(framework::InferShapeContext *ctx) const override {
-    OP_INOUT_CHECK(ctx->HasInput("X"), "Input", "X", "reveal");
+    OP_INOUT_CHECK(ctx->HasInputs("X"), "Input", "X", "reveal");
 
-    auto x_dims = ctx->GetInputDim("X");
-    std::vector<int64_t> output_dims;
-    for (size_t i = 1; i < x_dims.size(); i++) {
-      output_dims.push_back(x_dims[i]);
+    auto xs_dims = ctx->GetInputsDim("X");
+    PADDLE_ENFORCE_EQ(xs_dims.size(), ctx->Outputs("Out").size(),
+                      "Num of inputs and outputs of reveal should be equal.");
+    std::vector<framework::DDim> outs_dims;
+    for (auto& x_dims : xs_dims) {
+      std::vector<int64_t> output_dims;
+      for (size_t i = 1; i < x_dims.size(); i++) {
+        output_dims.push_back(x_dims[i]);
+      }
+      outs_dims.emplace_back(framework::make_ddim(output_dims));
+    }
+    ctx->SetOutputsDim("Out", outs_dims);
+    for (size_t i = 0; i < xs_dims.size(); ++i) {
+      ctx->ShareLoD("X", /*->*/ "Out", i, i);
     }
-    ctx->SetOutputDim("Out", framework::make_ddim(output_dims));
-    ctx->ShareLoD("X", /*->*/ "Out");
   }
 };
 
 class MpcRevealOpMaker : public framework::OpProtoAndCheckerMaker {
  public:
   void Make() override {
-    AddInput("X", "(Tensor) Input tensor of reveal operator.");
-    AddOutput("Out", "(Tensor) Output tensor of reveal operator.");
+    AddInput("X", "(Tensor) Input tensors of reveal operator.").AsDuplicable();
+    AddOutput("Out", "(Tensor) Output tensors of reveal operator.").AsDuplicable();
     AddComment(R"DOC(
 **reveal operator**
+
+All inputs are revealed in one round.
 )DOC");
   }
 };
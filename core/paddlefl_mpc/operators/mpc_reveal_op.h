@@ -24,12 +24,16 @@ template <typename DeviceContext, typename T>
 class MpcRevealKernel : public MpcOpKernel<T> {
  public:
   void ComputeImpl(const framework::ExecutionContext& ctx) const override {
-    const auto *in_t = ctx.Input<framework::Tensor>("X");
-    auto *out_t = ctx.Output<framework::Tensor>("Out");
+    auto ins = ctx.MultiInput<framework::Tensor>("X");
+    auto outs = ctx.MultiOutput<framework::Tensor>("Out");
 
     PADDLE_ENFORCE_NOT_NULL(mpc::MpcInstance::mpc_protocol, "Protocol %s is not yet created in MPC Protocol.");
     auto mpc_operator = mpc::MpcInstance::mpc_instance()->mpc_protocol()->mpc_operators();
-    mpc_operator->reveal(in_t, out_t);
+    if (ins.size() == 1) {
+      mpc_operator->reveal(ins[0], outs[0]);
+    } else {
+      mpc_operator->reveal_many(ins, outs);
+    }
   }
 };
 
@@ -182,7 +182,16 @@ public:
                      "default -1 for last dimension")
             .SetDefault(-1);
         AddAttr<bool>("use_relu", "").SetDefault(false);
-        AddAttr<bool>("use_long_div", "").SetDefault(true);
+        AddAttr<bool>("use_long_div",
+                      "(bool, default: true), divide by long division, "
+                      "otherwise by reciprocal of Newton's method.")
+            .SetDefault(true);
+        AddAttr<bool>("use_goldschmidt_div",
+                      "(bool, default: false), divide sum of exp by "
+                      "goldschmidt division in fewer rounds, ignored if "
+                      "use_relu is true.")
+            .SetDefault(false);
+        AddAttr<bool>("use_split_exp", "").SetDefault(false);
         AddComment(R"DOC(
 Softmax With Cross Entropy Operator.
 Cross entropy loss with softmax is used as the output layer extensively. This
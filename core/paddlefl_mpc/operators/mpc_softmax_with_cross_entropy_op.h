@@ -58,9 +58,12 @@ public:
         out_loss_t->mutable_data<T>(ctx.GetPlace());
         bool use_relu = ctx.Attr<bool>("use_relu");
         bool use_long_div = ctx.Attr<bool>("use_long_div");
+        bool use_goldschmidt_div = ctx.Attr<bool>("use_goldschmidt_div");
+        bool use_split_exp = ctx.Attr<bool>("use_split_exp");
 
         mpc::MpcInstance::mpc_instance()->mpc_protocol()->mpc_operators()->softmax(
-            in_x_t, out_softmax_t, use_relu, use_long_div);
+            in_x_t, out_softmax_t, use_relu, use_long_div,
+            use_goldschmidt_div, use_split_exp);
     }
 };
 
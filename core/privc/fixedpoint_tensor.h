@@ -94,6 +94,13 @@ public:
     // exp
     void exp(FixedPointTensor<T, N>* ret, size_t iter = 8) const;
 
+    // exp by splitting x * log2(e) into integer and fractional parts,
+    // 2^integer by a multiplexer tree over its bits in gc and
+    // 2^fraction by a polynomial. e^x = 0 if x * log2(e) < -2^K and
+    // e^x = 2^(2^K) if x * log2(e) >= 2^K, for the largest
+    // K <= floor(log2(N)) with 2^K + N < 63, i.e. K = 4 for N = 32
+    void exp_split(FixedPointTensor<T, N>* ret) const;
+
     // element-wise mul with FixedPointTensor using truncate1
     void mul(const FixedPointTensor* rhs, FixedPointTensor* ret) const;
 
@@ -125,7 +132,9 @@ public:
     void sigmoid(FixedPointTensor* ret) const;
 
     // element-wise softmax
-    void softmax(FixedPointTensor* ret, bool use_relu = false) const;
+    // use_split_exp: exp by exp_split, otherwise by exp
+    void softmax(FixedPointTensor* ret, bool use_relu = false,
+                 bool use_split_exp = false) const;
 
     // matrix argmax
     // return max index in one-hot
@@ -1228,6 +1228,126 @@ void FixedPointTensor<T, N>::sigmoid(FixedPointTensor<T, N>* ret) const {
     to_ac_num(res_lsb.get(), ret->mutable_share());
 }
 
+template<typename T, size_t N>
+void FixedPointTensor<T, N>::exp_split(FixedPointTensor<T, N>* ret) const {
+    // e^x = 2^y = 2^floor(y) * 2^t, y = x * log2(e), t = y - floor(y).
+    // floor(y) = sum(b_i * 2^i) - s * 2^K for y in [-2^K, 2^K), so
+    // 2^floor(y) is selected from 2^(K + 1) public values by its
+    // bits b_i and sign s
+    PADDLE_ENFORCE_EQ(ret->numel(), numel(), "input numel mot match.");
+    const size_t bit_len = sizeof(int64_t) * 8;
+    // 2^(2^K) with N fractional bits must be below 2^(bit_len - 1)
+    size_t K = std::log2(N);
+    while (((size_t) 1 << K) + N >= bit_len - 1) {
+        --K;
+    }
+
+    auto log2e = tensor_factory()->template create<T>(shape());
+    common::assign_to_tensor(log2e.get(),
+                             (T) (std::log2(std::exp(1.0)) * pow(2, N)));
+    log2e->scaling_factor() = N;
+    auto y_ = tensor_factory()->template create<T>(shape());
+    FixedPointTensor<T, N> y(y_.get());
+    this->mul(log2e.get(), &y);
+
+    // ac to gc
+    auto gc_shape = get_gc_shape(shape());
+    auto bit_shape = gc_shape;
+    bit_shape.erase(bit_shape.begin());
+    auto x0 = tensor_factory()->template create<int64_t>(gc_shape);
+    auto x1 = tensor_factory()->template create<int64_t>(gc_shape);
+    auto gc = tensor_factory()->template create<int64_t>(gc_shape);
+
+    to_gc_num(y.share(), 0, x0.get());
+    to_gc_num(y.share(), 1, x1.get());
+    gc_add(x0.get(), x1.get(), gc.get());
+
+    // multiplexer tree, level l selects by b_l or s for l = K
+    std::vector<std::shared_ptr<TensorBlock>> nodes;
+    for (size_t i = 0; i < ((size_t) 2 << K); ++i) {
+        int exponent = (int) (i % (1 << K)) - (int) ((i >> K) << K);
+        nodes.emplace_back(create_gc_share(gc_shape));
+        privc::to_gc_num(std::pow(2.0, exponent), nodes.back().get(), N);
+    }
+    for (size_t l = 0; l <= K; ++l) {
+        auto cond = (*gc)[l < K ? N + l : bit_len - 1];
+        std::vector<std::shared_ptr<TensorBlock>> next;
+        for (size_t i = 0; i < nodes.size(); i += 2) {
+            privc::if_then_else(nodes[i].get(), nodes[i + 1].get(),
+                                nodes[i].get(), bit_len, cond.get());
+            next.emplace_back(nodes[i]);
+        }
+        nodes.swap(next);
+    }
+    auto pow_int = nodes[0];
+
+    auto zero = create_gc_share(gc_shape);
+    auto bound = create_gc_share(gc_shape);
+    auto in_range = create_gc_share(bit_shape);
+    auto overflow = create_gc_share(bit_shape);
+    privc::to_gc_num(0.0, zero.get(), N);
+    privc::to_gc_num(-std::pow(2.0, K), bound.get(), N);
+    geq(gc.get(), bound.get(), in_range.get());
+    privc::to_gc_num(std::pow(2.0, K), bound.get(), N);
+    geq(gc.get(), bound.get(), overflow.get());
+
+    // t = low N bits of y
+    auto t_gc = create_gc_share(gc_shape);
+    zero->copy(t_gc.get());
+    for (size_t i = 0; i < N; ++i) {
+        (*gc)[i]->copy((*t_gc)[i].get());
+    }
+
+    // 2^floor(y) = 0 if y < -2^K, 2^(2^K) with t = 0 if y >= 2^K
+    privc::if_then_else(pow_int.get(), pow_int.get(), zero.get(),
+                        bit_len, in_range.get());
+    privc::to_gc_num(std::pow(2.0, 1 << K), bound.get(), N);
+    privc::if_then_else(pow_int.get(), bound.get(), pow_int.get(),
+                        bit_len, overflow.get());
+    privc::if_then_else(t_gc.get(), zero.get(), t_gc.get(),
+                        bit_len, overflow.get());
+
+    // gc to ac
+    auto pow_bc = tensor_factory()->template create<int64_t>(shape());
+    auto t_bc = tensor_factory()->template create<int64_t>(shape());
+    lsb(pow_int.get(), pow_bc.get());
+    lsb(t_gc.get(), t_bc.get());
+    std::vector<std::shared_ptr<TensorAdapter<T>>> temp;
+    for (int i = 0; i < 7; ++i) {
+        temp.emplace_back(tensor_factory()->template create<T>(shape()));
+    }
+    FixedPointTensor<T, N> pow_ac(temp[0].get());
+    FixedPointTensor<T, N> t(temp[1].get());
+    to_ac_num(pow_bc.get(), pow_ac.mutable_share());
+    to_ac_num(t_bc.get(), t.mutable_share());
+
+    // 2^t by a degree 4 fit on [0, 1), rel err < 4e-6
+    const std::vector<double> c = { 1.0000034929, 0.6929729222, 0.2416043573,
+                                    0.0517449978, 0.0136703095 };
+    FixedPointTensor<T, N> t2(temp[2].get());
+    FixedPointTensor<T, N> t3(temp[3].get());
+    FixedPointTensor<T, N> t4(temp[4].get());
+    FixedPointTensor<T, N> p(temp[5].get());
+    FixedPointTensor<T, N> term(temp[6].get());
+    t.mul(&t, &t2);
+    t2.mul(&t, &t3);
+    t2.mul(&t2, &t4);
+
+    auto coeff = tensor_factory()->template create<T>(shape());
+    coeff->scaling_factor() = N;
+    common::assign_to_tensor(p.mutable_share(), (T) 0);
+    common::assign_to_tensor(coeff.get(), (T) (c[0] * pow(2, N)));
+    p.add(coeff.get(), &p);
+    const FixedPointTensor<T, N>* powers[4] = { &t, &t2, &t3, &t4 };
+    for (size_t i = 1; i < c.size(); ++i) {
+        common::assign_to_tensor(coeff.get(), (T) (c[i] * pow(2, N)));
+        powers[i - 1]->mul(coeff.get(), &term);
+        p.add(&term, &p);
+    }
+
+    pow_ac.mul(&p, ret);
+}
+
 template<typename T, size_t N>
 void FixedPointTensor<T, N>::argmax(FixedPointTensor<T, N>* ret) const {
     PADDLE_ENFORCE_EQ(ret->shape()[1], shape()[1],
@@ -1321,11 +1441,14 @@ void FixedPointTensor<T, N>::reduce(FixedPointTensor<T, N>* ret) const {
 
 template<typename T, size_t N>
 void FixedPointTensor<T, N>::softmax(FixedPointTensor<T, N>* ret,
-                                     bool use_relu) const {
+                                     bool use_relu,
+                                     bool use_split_exp) const {
     auto tmp = tensor_factory()->template create<int64_t>(shape());
     FixedPointTensor<T, N> x(tmp.get());
     if (use_relu) {
         this->relu(&x);
+    } else if (use_split_exp) {
+        this->exp_split(&x);
     } else {
         this->exp(&x);
     }
@@ -21,7 +21,7 @@ limitations under the License. */
 #include "paddle/fluid/framework/scope.h"
 
 #include "./privc_context.h"
-#include "core/paddlefl_mpc/mpc_protocol/network/mesh_network.h"
+#include "core/paddlefl_mpc/mpc_protocol/network/mesh_network_shm.h"
 #include "core/paddlefl_mpc/mpc_protocol/context_holder.h"
 #include "fixedpoint_tensor.h"
 #include "core/common/paddle_tensor.h"
@@ -37,7 +37,6 @@ public:
     static paddle::platform::CPUDeviceContext _cpu_ctx;
     static std::shared_ptr<paddle::framework::ExecutionContext> _exec_ctx;
     static std::shared_ptr<AbstractContext> _mpc_ctx[2];
-    static std::shared_ptr<gloo::rendezvous::HashStore> _store;
     static std::thread _t[2];
     static std::shared_ptr<TensorAdapterFactory> _s_tensor_factory;
 
@@ -51,8 +50,6 @@ public:
 
         _exec_ctx = std::make_shared<paddle::framework::ExecutionContext>(
             *op, scope, _cpu_ctx, ctx);
-        _store = std::make_shared<gloo::rendezvous::HashStore>();
-
         for (size_t i = 0; i < 2; ++i) {
             _t[i] = std::thread(&FixedTensorTest::gen_mpc_ctx, i);
         }
@@ -63,12 +60,8 @@ public:
         _s_tensor_factory = std::make_shared<common::PaddleTensorFactory>(&_cpu_ctx);
     }
 
-    static inline std::shared_ptr<paddle::mpc::MeshNetwork> gen_network(size_t idx) {
-        return std::make_shared<paddle::mpc::MeshNetwork>(idx,
-                                                          "127.0.0.1",
-                                                          2,
-                                                          "test_prefix_privc",
-                                                          _store);
+    static inline std::shared_ptr<paddle::mpc::MeshNetworkShm> gen_network(size_t idx) {
+        return std::make_shared<paddle::mpc::MeshNetworkShm>(idx, 2, "test_prefix_privc");
     }
     static inline void gen_mpc_ctx(size_t idx) {
         auto net = gen_network(idx);
@@ -410,6 +403,54 @@ TEST_F(FixedTensorTest, exp) {
     EXPECT_NEAR(std::exp(-2.0), p->data()[1] / std::pow(2, PRIVC_FIXED_POINT_SCALING_FACTOR), 0.1);
 }
 
+TEST_F(FixedTensorTest, exp_split) {
+    std::vector<size_t> shape = { 5 };
+    std::shared_ptr<TensorAdapter<int64_t>> sl[2] = { gen(shape), gen(shape) };
+    std::shared_ptr<TensorAdapter<int64_t>> ret[2] = { gen(shape), gen(shape) };
+    // lhs = (3, -2, 10, 25, -20), 25 and -20 out of range
+    std::vector<double> in = { 3, -2, 10, 25, -20 };
+    std::vector<double> expected = { std::exp(3.0), std::exp(-2.0),
+                                     std::exp(10.0), std::pow(2.0, 16), 0 };
+    for (size_t i = 0; i < in.size(); ++i) {
+        sl[0]->data()[i] = (int64_t) ((in[i] + 1) * std::pow(2, PRIVC_FIXED_POINT_SCALING_FACTOR));
+        sl[1]->data()[i] = (int64_t)-1 << PRIVC_FIXED_POINT_SCALING_FACTOR;
+    }
+
+    auto p = gen(shape);
+
+    Fix64N32 fl0(sl[0].get());
+    Fix64N32 fl1(sl[1].get());
+    Fix64N32 fout0(ret[0].get());
+    Fix64N32 fout1(ret[1].get());
+
+    _t[0] = std::thread(
+        [&] () {
+        g_ctx_holder::template run_with_context(
+            _exec_ctx.get(), _mpc_ctx[0], [&](){
+                fl0.exp_split(&fout0);
+                fout0.reveal_to_one(0, p.get());
+            });
+        }
+    );
+    _t[1] = std::thread(
+        [&] () {
+        g_ctx_holder::template run_with_context(
+            _exec_ctx.get(), _mpc_ctx[1], [&](){
+                fl1.exp_split(&fout1);
+                fout1.reveal_to_one(0, nullptr);
+            });
+        }
+    );
+    for (auto &t: _t) {
+        t.join();
+    }
+    for (size_t i = 0; i < in.size(); ++i) {
+        // relative error of 2^t fit is below 4e-6
+        EXPECT_NEAR(expected[i], p->data()[i] / std::pow(2, PRIVC_FIXED_POINT_SCALING_FACTOR),
+                    1e-3 + expected[i] * 1e-5);
+    }
+}
+
 TEST_F(FixedTensorTest, mulfixed) {
     std::vector<size_t> shape = { 1 };
     std::shared_ptr<TensorAdapter<int64_t>> sl[2] = { gen(shape), gen(shape) };
@@ -969,7 +1010,6 @@ TEST_F(FixedTensorTest, softmax) {
 paddle::platform::CPUDeviceContext privc::FixedTensorTest::_cpu_ctx;
 std::shared_ptr<paddle::framework::ExecutionContext> privc::FixedTensorTest::_exec_ctx;
 std::shared_ptr<AbstractContext> privc::FixedTensorTest::_mpc_ctx[2];
-std::shared_ptr<gloo::rendezvous::HashStore> privc::FixedTensorTest::_store;
 std::thread privc::FixedTensorTest::_t[2];
 std::shared_ptr<TensorAdapterFactory> privc::FixedTensorTest::_s_tensor_factory;
 
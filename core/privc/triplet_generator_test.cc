@@ -21,7 +21,7 @@ limitations under the License. */
 #include "paddle/fluid/framework/scope.h"
 
 #include "./privc_context.h"
-#include "core/paddlefl_mpc/mpc_protocol/network/mesh_network.h"
+#include "core/paddlefl_mpc/mpc_protocol/network/mesh_network_shm.h"
 #include "core/paddlefl_mpc/mpc_protocol/context_holder.h"
 #include "fixedpoint_tensor.h"
 #include "core/privc/he_triplet.h"
@@ -38,7 +38,6 @@ public:
     static paddle::platform::CPUDeviceContext _cpu_ctx;
     static std::shared_ptr<paddle::framework::ExecutionContext> _exec_ctx;
     static std::shared_ptr<AbstractContext> _mpc_ctx[2];
-    static std::shared_ptr<gloo::rendezvous::HashStore> _store;
     static std::thread _t[2];
     static std::shared_ptr<TensorAdapterFactory> _s_tensor_factory;
 
@@ -52,8 +51,6 @@ public:
 
         _exec_ctx = std::make_shared<paddle::framework::ExecutionContext>(
             *op, scope, _cpu_ctx, ctx);
-        _store = std::make_shared<gloo::rendezvous::HashStore>();
-
         for (size_t i = 0; i < 2; ++i) {
             _t[i] = std::thread(&TripletGeneratorTest::gen_mpc_ctx, i);
         }
@@ -64,12 +61,8 @@ public:
         _s_tensor_factory = std::make_shared<common::PaddleTensorFactory>(&_cpu_ctx);
     }
 
-    static inline std::shared_ptr<paddle::mpc::MeshNetwork> gen_network(size_t idx) {
-        return std::make_shared<paddle::mpc::MeshNetwork>(idx,
-                                                          "127.0.0.1",
-                                                          2,
-                                                          "test_prefix_privc",
-                                                          _store);
+    static inline std::shared_ptr<paddle::mpc::MeshNetworkShm> gen_network(size_t idx) {
+        return std::make_shared<paddle::mpc::MeshNetworkShm>(idx, 2, "test_prefix_privc");
     }
     static inline void gen_mpc_ctx(size_t idx) {
         auto net = gen_network(idx);
@@ -192,7 +185,6 @@ TEST_F(TripletGeneratorTest, penta_triplet) {
 paddle::platform::CPUDeviceContext privc::TripletGeneratorTest::_cpu_ctx;
 std::shared_ptr<paddle::framework::ExecutionContext> privc::TripletGeneratorTest::_exec_ctx;
 std::shared_ptr<AbstractContext> privc::TripletGeneratorTest::_mpc_ctx[2];
-std::shared_ptr<gloo::rendezvous::HashStore> privc::TripletGeneratorTest::_store;
 std::thread privc::TripletGeneratorTest::_t[2];
 std::shared_ptr<TensorAdapterFactory> privc::TripletGeneratorTest::_s_tensor_factory;
 
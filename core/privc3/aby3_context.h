@@ -18,6 +18,7 @@
 
 #include "core/paddlefl_mpc/mpc_protocol/abstract_context.h"
 #include "core/paddlefl_mpc/mpc_protocol/abstract_network.h"
+#include "correlated_randomness_store.h"
 #include "prng_utils.h"
 
 namespace aby3 {
@@ -48,14 +49,7 @@ public:
     size_t party_pre = pre_party();
     size_t party_next = next_party();
 
-    if (party == 1) {
-      block recv_seed = this->network()->template recv<block>(party_next);
-      this->network()->template send(party_pre, seed);
-      seed = recv_seed;
-    } else {
-      this->network()->template send(party_pre, seed);
-      seed = this->network()->template recv<block>(party_next);
-    }
+    seed = this->network()->template send_recv(party_pre, seed, party_next);
 
     set_random_seed(seed, 1);
   }
@@ -63,12 +57,17 @@ public:
   ABY3Context(const ABY3Context &other) = delete;
 
   ABY3Context &operator=(const ABY3Context &other) = delete;
+
+  // preprocessed randomness of this context
+  CorrelatedRandomnessStore& store() { return _store; }
+
 protected:
   PseudorandomNumberGenerator& get_prng(size_t idx) override {
     return _prng[idx];
   }
 private:
   PseudorandomNumberGenerator _prng[3];
+  CorrelatedRandomnessStore _store;
 };
 
 } // namespace aby3
@@ -30,6 +30,9 @@ namespace aby3 {
 template<typename T, size_t N>
 class FixedPointTensor;
 
+// num of elements transposed into bit-planes at a time by ppa
+const size_t BIT_SLICE_BATCH = 128;
+
 template<typename T>
 class BooleanTensor {
 
@@ -57,6 +60,10 @@ public:
     // reveal boolean tensor to all parties
     void reveal(TensorAdapter<T>* ret) const;
 
+    // reveal boolean tensors to all parties in one round
+    static void reveal_many(const std::vector<const BooleanTensor*>& ins,
+                            const std::vector<TensorAdapter<T>*>& rets);
+
     const std::vector<size_t> shape() const;
 
     size_t numel() const;
@@ -83,6 +90,14 @@ public:
     template<template<typename U> class CTensor>
     void bitwise_or(const CTensor<T>* rhs, BooleanTensor* ret) const;
 
+    // element-wise and of one-bit boolean shares
+    // only lsb of each element is significant and kept in ret,
+    // lsbs are packed 64 per word on the wire
+    void bit_and(const BooleanTensor* rhs, BooleanTensor* ret) const;
+
+    // element-wise or of one-bit boolean shares
+    void bit_or(const BooleanTensor* rhs, BooleanTensor* ret) const;
+
     // element-wise not
     void bitwise_not(BooleanTensor* ret) const;
 
@@ -96,6 +111,8 @@ public:
     void logical_rshift(size_t rhs, BooleanTensor* ret) const;
 
     // element-wise ppa with BooleanTensor
+    // tensors of 64-bit elements with at least BIT_SLICE_BATCH elements
+    // are added in bit-sliced mode
     void ppa(const BooleanTensor* rhs, BooleanTensor*ret , size_t nbits) const;
 
     // ABY3 b2a
@@ -119,6 +136,16 @@ public:
     // extract from this to ret
     void bit_extract(size_t i, BooleanTensor* ret) const;
 
+    // msb of in to bit 0 of this, same as bit_extract of msb
+    // while only the carry into msb is computed
+    template<size_t N>
+    void msb(const FixedPointTensor<T, N>* in);
+
+    // msb of in[i] to ret[i], all in one run of the circuit
+    template<size_t N>
+    static void msb(const std::vector<const FixedPointTensor<T, N>*>& in,
+                    const std::vector<BooleanTensor*>& ret);
+
     // turn all 1s to 0s except the last 1 in a col
     // given cmp result from max pooling, generate one hot tensor
     // indicating which element is max
@@ -134,6 +161,13 @@ private:
         return paddle::mpc::ContextHolder::tensor_factory();
     }
 
+    // ppa on bit-planes of 128 elements, see ppa
+    void ppa_bit_sliced(const BooleanTensor* rhs, BooleanTensor* ret,
+                        size_t n_bits) const;
+
+    // msb of this + rhs on bit-planes, to bit 0 of ret
+    void msb_bit_sliced(const BooleanTensor* rhs, BooleanTensor* ret) const;
+
     size_t pre_party() const;
 
     size_t next_party() const;
@@ -15,6 +15,9 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
+
+#include "core/common/sse_transpose.h"
 #include "core/privc3/ot.h"
 
 namespace aby3 {
@@ -87,8 +90,51 @@ void BooleanTensor<T>::reveal_to_one(size_t party_num, TensorAdapter<T>* ret) co
 
 template<typename T>
 void BooleanTensor<T>::reveal(TensorAdapter<T>* ret) const {
-    for (size_t idx = 0; idx < 3; ++idx) {
-        reveal_to_one(idx, ret);
+    // one round: send share 0 to next party, recv from pre party
+    auto buffer = tensor_factory()->template create<T>(ret->shape());
+    aby3_ctx()->network()->template send_recv(next_party(), *share(0),
+                                              pre_party(), *buffer);
+
+    share(0)->bitwise_xor(buffer.get(), ret);
+    share(1)->bitwise_xor(ret, ret);
+}
+
+template<typename T>
+void BooleanTensor<T>::reveal_many(const std::vector<const BooleanTensor*>& ins,
+                                   const std::vector<TensorAdapter<T>*>& rets) {
+    PADDLE_ENFORCE_EQ(ins.size(), rets.size(),
+                      "Num of inputs and outputs should be equal.");
+    size_t numel = 0;
+    for (auto in : ins) {
+        numel += in->share(0)->numel();
+    }
+
+    // share 0 of all tensors in one msg
+    std::vector<T> send_buf(numel);
+    std::vector<T> recv_buf(numel);
+    T* ptr = send_buf.data();
+    for (auto in : ins) {
+        ptr = std::copy(in->share(0)->data(),
+                        in->share(0)->data() + in->share(0)->numel(), ptr);
+    }
+
+    auto ctx = aby3_ctx();
+    ctx->network()->send_recv(ctx->next_party(), send_buf.data(),
+                              numel * sizeof(T), ctx->pre_party(),
+                              recv_buf.data(), numel * sizeof(T));
+
+    const T* missing = recv_buf.data();
+    for (size_t i = 0; i < ins.size(); ++i) {
+        const size_t n = ins[i]->share(0)->numel();
+        PADDLE_ENFORCE_EQ(rets[i]->numel(), n,
+                          "Shape of input and output should be equal.");
+        const T* s0 = ins[i]->share(0)->data();
+        const T* s1 = ins[i]->share(1)->data();
+        T* ret = rets[i]->data();
+        for (size_t j = 0; j < n; ++j) {
+            ret[j] = s0[j] ^ s1[j] ^ missing[j];
+        }
+        missing += n;
     }
 }
 
@@ -145,18 +191,92 @@ void BooleanTensor<T>::bitwise_and(const BooleanTensor* rhs,
     tmp0->bitwise_xor(tmp2.get(), tmp0.get());
     tmp0->bitwise_xor(tmp_zero.get(), ret->share(0));
 
-    // 3-party msg send recv sequence
+    // 3-party msg exchange, all in one round
     //       p0      p1      p2
-    // t0:  0->2            2<-0
-    // t1:          1<-2    2->1
-    // t2:  0<-1    1->2
-    if (party() > 0) {
-        aby3_ctx()->network()->template recv(next_party(), *(ret->share(1)));
-        aby3_ctx()->network()->template send(pre_party(), *(ret->share(0)));
-    } else {
-        aby3_ctx()->network()->template send(pre_party(), *(ret->share(0)));
-        aby3_ctx()->network()->template recv(next_party(), *(ret->share(1)));
+    // t0:  0->2    1->0    2->1
+    //      0<-1    1<-2    2<-0
+    aby3_ctx()->network()->template send_recv(pre_party(), *(ret->share(0)),
+                                              next_party(), *(ret->share(1)));
+}
+
+// pack lsb of each element of in, 64 elements per word
+template<typename T>
+void pack_lsb(const TensorAdapter<T>* in, uint64_t* out) {
+    const size_t numel = in->numel();
+    std::fill(out, out + (numel + 63) / 64, 0);
+    for (size_t i = 0; i < numel; ++i) {
+        out[i / 64] |= uint64_t(in->data()[i] & 1) << (i % 64);
+    }
+}
+
+template<typename T>
+void unpack_lsb(const uint64_t* in, TensorAdapter<T>* out) {
+    for (size_t i = 0; i < out->numel(); ++i) {
+        out->data()[i] = (in[i / 64] >> (i % 64)) & 1;
+    }
+}
+
+// send_recv of one-bit shares, only lsbs are exchanged
+template<typename T>
+void send_recv_lsb(AbstractContext* aby3_ctx,
+                   size_t send_party, const TensorAdapter<T>* send_tensor,
+                   size_t recv_party, TensorAdapter<T>* recv_tensor) {
+    std::vector<uint64_t> send_buf((send_tensor->numel() + 63) / 64);
+    std::vector<uint64_t> recv_buf((recv_tensor->numel() + 63) / 64);
+    pack_lsb(send_tensor, send_buf.data());
+
+    aby3_ctx->network()->send_recv(send_party, send_buf.data(),
+                                   send_buf.size() * sizeof(uint64_t),
+                                   recv_party, recv_buf.data(),
+                                   recv_buf.size() * sizeof(uint64_t));
+
+    unpack_lsb(recv_buf.data(), recv_tensor);
+}
+
+template<typename T>
+void BooleanTensor<T>::bit_and(const BooleanTensor* rhs,
+                               BooleanTensor* ret) const {
+
+    auto tmp_zero = tensor_factory()->template create<T>(ret->shape());
+    auto tmp0 = tensor_factory()->template create<T>(ret->shape());
+    auto tmp1 = tensor_factory()->template create<T>(ret->shape());
+    auto tmp2 = tensor_factory()->template create<T>(ret->shape());
+
+    aby3_ctx()->template gen_zero_sharing_boolean(*tmp_zero.get());
+
+    share(0)->bitwise_and(rhs->share(0), tmp0.get());
+    share(0)->bitwise_and(rhs->share(1), tmp1.get());
+    share(1)->bitwise_and(rhs->share(0), tmp2.get());
+
+    tmp0->bitwise_xor(tmp1.get(), tmp0.get());
+    tmp0->bitwise_xor(tmp2.get(), tmp0.get());
+    tmp0->bitwise_xor(tmp_zero.get(), tmp0.get());
+
+    // lsbs of a zero sharing are still a zero sharing
+    std::transform(tmp0->data(), tmp0->data() + tmp0->numel(),
+                   ret->share(0)->data(), [](T in) -> T { return in & 1; });
+
+    send_recv_lsb(aby3_ctx().get(), pre_party(), ret->share(0),
+                  next_party(), ret->share(1));
+}
+
+template<typename T>
+void BooleanTensor<T>::bit_or(const BooleanTensor* rhs,
+                              BooleanTensor* ret) const {
+    std::vector<std::shared_ptr<TensorAdapter<T>>> tmp;
+
+    for (int i = 0; i < 2; ++i) {
+        tmp.emplace_back(
+            tensor_factory()->template create<T>(shape()));
     }
+
+    BooleanTensor buffer(tmp[0].get(), tmp[1].get());
+    // ret = x & y ^ x ^ y
+    bit_and(rhs, &buffer);
+    bitwise_xor(&buffer, &buffer);
+    buffer.bitwise_xor(rhs, ret);
+    // clear high bits of inputs
+    ret->bit_extract(0, ret);
 }
 
 template<typename T>
@@ -219,10 +339,273 @@ void BooleanTensor<T>::logical_rshift(size_t rhs, BooleanTensor* ret) const {
     share(1)->logical_rshift(rhs, ret->share(1));
 }
 
+using common::block;
+
+// bit-planes of a boolean tensor of 64-bit elements, plane j of share i
+// is planes[i][j * num_blocks, (j + 1) * num_blocks), block b of which
+// holds bit j of elements [b * 128, (b + 1) * 128)
+template<typename T>
+void to_bit_planes(const BooleanTensor<T>* in, size_t num_blocks,
+                   std::vector<block> planes[2]) {
+    const size_t numel = in->numel();
+    const T* in0 = in->share(0)->data();
+    const T* in1 = in->share(1)->data();
+    planes[0].resize(64 * num_blocks);
+    planes[1].resize(64 * num_blocks);
+
+    // row r of a block is (share 0, share 1) of one element,
+    // so one transpose gets planes of both shares
+    std::array<block, 128> rows;
+    for (size_t b = 0; b < num_blocks; ++b) {
+        for (size_t r = 0; r < 128; ++r) {
+            size_t idx = b * 128 + r;
+            rows[r] = idx < numel ? _mm_set_epi64x(in1[idx], in0[idx])
+                                  : _mm_setzero_si128();
+        }
+        common::sse_transpose128(rows);
+        for (size_t j = 0; j < 64; ++j) {
+            planes[0][j * num_blocks + b] = rows[j];
+            planes[1][j * num_blocks + b] = rows[64 + j];
+        }
+    }
+}
+
+template<typename T>
+void from_bit_planes(const std::vector<block> planes[2], size_t num_blocks,
+                     BooleanTensor<T>* out) {
+    const size_t numel = out->numel();
+    T* out0 = out->share(0)->data();
+    T* out1 = out->share(1)->data();
+
+    std::array<block, 128> rows;
+    int64_t row[2];
+    for (size_t b = 0; b < num_blocks; ++b) {
+        for (size_t j = 0; j < 64; ++j) {
+            rows[j] = planes[0][j * num_blocks + b];
+            rows[64 + j] = planes[1][j * num_blocks + b];
+        }
+        common::sse_transpose128(rows);
+        for (size_t r = 0; r < 128 && b * 128 + r < numel; ++r) {
+            _mm_storeu_si128(reinterpret_cast<block*>(row), rows[r]);
+            out0[b * 128 + r] = row[0];
+            out1[b * 128 + r] = row[1];
+        }
+    }
+}
+
+// z = a & b on bit-planes, a[i][k] is share i of k-th plane of a
+// all planes are anded in one round
+template<typename T>
+void bit_sliced_and(AbstractContext* aby3_ctx,
+                    TensorAdapterFactory* tensor_factory,
+                    size_t num_blocks,
+                    const std::vector<const block*> a[2],
+                    const std::vector<const block*> b[2],
+                    std::vector<block> z[2]) {
+    const size_t num_planes = a[0].size();
+    const size_t len = num_planes * num_blocks;
+    z[0].resize(len);
+    z[1].resize(len);
+
+    // 2 elements of T per block
+    auto zero = tensor_factory->template create<T>({2 * len});
+    aby3_ctx->template gen_zero_sharing_boolean(*zero);
+    const block* zero_ = reinterpret_cast<const block*>(zero->data());
+
+    for (size_t k = 0; k < num_planes; ++k) {
+        const block* a0 = a[0][k];
+        const block* a1 = a[1][k];
+        const block* b0 = b[0][k];
+        const block* b1 = b[1][k];
+        block* z0 = z[0].data() + k * num_blocks;
+        for (size_t i = 0; i < num_blocks; ++i) {
+            block t = _mm_and_si128(a0[i], _mm_xor_si128(b0[i], b1[i]));
+            t = _mm_xor_si128(t, _mm_and_si128(a1[i], b0[i]));
+            z0[i] = _mm_xor_si128(
+                t, _mm_loadu_si128(zero_ + k * num_blocks + i));
+        }
+    }
+
+    aby3_ctx->network()->send_recv(aby3_ctx->pre_party(), z[0].data(),
+                                   len * sizeof(block),
+                                   aby3_ctx->next_party(), z[1].data(),
+                                   len * sizeof(block));
+}
+
+template<typename T>
+void BooleanTensor<T>::ppa_bit_sliced(const BooleanTensor* rhs,
+                                      BooleanTensor* ret,
+                                      size_t n_bits) const {
+    // same kogge stone adder as ppa, while a level of it is evaluated
+    // on bit-planes with simd, in which shifts are free and bits
+    // shifted in are skipped. g and p of a level are anded in one round
+    const size_t k = std::ceil(std::log2(n_bits));
+    const size_t num_blocks = (ret->numel() + 127) / 128;
+    auto plane = [num_blocks](const std::vector<block>& planes, size_t j) {
+        return planes.data() + j * num_blocks;
+    };
+    auto xor_ = [](block lhs, block rhs) { return _mm_xor_si128(lhs, rhs); };
+
+    std::vector<block> x[2];
+    std::vector<block> y[2];
+    std::vector<block> g[2];
+    std::vector<block> p[2];
+    std::vector<block> z[2];
+    to_bit_planes(this, num_blocks, x);
+    to_bit_planes(rhs, num_blocks, y);
+
+    std::vector<const block*> a_[2];
+    std::vector<const block*> b_[2];
+    for (size_t i = 0; i < 2; ++i) {
+        for (size_t j = 0; j < 64; ++j) {
+            a_[i].emplace_back(plane(x[i], j));
+            b_[i].emplace_back(plane(y[i], j));
+        }
+        p[i].resize(x[i].size());
+        std::transform(x[i].begin(), x[i].end(), y[i].begin(), p[i].begin(),
+                       xor_);
+    }
+    bit_sliced_and<T>(aby3_ctx().get(), tensor_factory().get(),
+                      num_blocks, a_, b_, g);
+
+    for (size_t l = 0; l < k; ++l) {
+        const size_t d = size_t(1) << l;
+        // g_j ^= g_{j - d} & p_j, p_j &= p_{j - d}, for j >= d
+        for (size_t i = 0; i < 2; ++i) {
+            a_[i].clear();
+            b_[i].clear();
+            for (size_t j = d; j < 64; ++j) {
+                a_[i].emplace_back(plane(g[i], j - d));
+                b_[i].emplace_back(plane(p[i], j));
+            }
+            for (size_t j = d; j < 64; ++j) {
+                a_[i].emplace_back(plane(p[i], j));
+                b_[i].emplace_back(plane(p[i], j - d));
+            }
+        }
+        bit_sliced_and<T>(aby3_ctx().get(), tensor_factory().get(),
+                          num_blocks, a_, b_, z);
+
+        const size_t len = (64 - d) * num_blocks;
+        for (size_t i = 0; i < 2; ++i) {
+            block* g_ = g[i].data() + d * num_blocks;
+            std::transform(g_, g_ + len, z[i].begin(), g_, xor_);
+            std::copy(z[i].begin() + len, z[i].end(),
+                      p[i].begin() + d * num_blocks);
+        }
+    }
+
+    // ret = g << 1 ^ x ^ y
+    for (size_t i = 0; i < 2; ++i) {
+        std::transform(x[i].begin(), x[i].end(), y[i].begin(), p[i].begin(),
+                       xor_);
+        std::transform(p[i].begin() + num_blocks, p[i].end(), g[i].begin(),
+                       p[i].begin() + num_blocks, xor_);
+    }
+    from_bit_planes(p, num_blocks, ret);
+}
+
+template<typename T>
+void BooleanTensor<T>::msb_bit_sliced(const BooleanTensor* rhs,
+                                      BooleanTensor* ret) const {
+    // only carry into msb is computed, by reducing (g, p) of bits below
+    // msb pairwise in a tree, so log2(63) levels of a few planes each
+    const size_t n = sizeof(T) * 8 - 1;
+    const size_t numel = ret->numel();
+    const size_t num_blocks = (numel + 127) / 128;
+    auto plane = [num_blocks](const std::vector<block>& planes, size_t j) {
+        return planes.data() + j * num_blocks;
+    };
+    auto xor_ = [](block lhs, block rhs) { return _mm_xor_si128(lhs, rhs); };
+
+    std::vector<block> x[2];
+    std::vector<block> y[2];
+    std::vector<block> g[2];
+    std::vector<block> p[2];
+    std::vector<block> z[2];
+    to_bit_planes(this, num_blocks, x);
+    to_bit_planes(rhs, num_blocks, y);
+
+    // g = x & y, p = x ^ y of bits below msb
+    std::vector<const block*> a_[2];
+    std::vector<const block*> b_[2];
+    for (size_t i = 0; i < 2; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            a_[i].emplace_back(plane(x[i], j));
+            b_[i].emplace_back(plane(y[i], j));
+        }
+        p[i].resize(n * num_blocks);
+        std::transform(x[i].begin(), x[i].begin() + n * num_blocks,
+                       y[i].begin(), p[i].begin(), xor_);
+    }
+    bit_sliced_and<T>(aby3_ctx().get(), tensor_factory().get(),
+                      num_blocks, a_, b_, g);
+
+    // node 2j and 2j + 1 are combined into
+    // (g_hi ^ p_hi & g_lo, p_hi & p_lo)
+    // p of node 0 is never used, for node 0 is always the lower one
+    for (size_t m = n; m > 1; m = (m + 1) / 2) {
+        const size_t h = m / 2;
+        for (size_t i = 0; i < 2; ++i) {
+            a_[i].clear();
+            b_[i].clear();
+            for (size_t j = 0; j < h; ++j) {
+                a_[i].emplace_back(plane(p[i], 2 * j + 1));
+                b_[i].emplace_back(plane(g[i], 2 * j));
+            }
+            for (size_t j = 1; j < h; ++j) {
+                a_[i].emplace_back(plane(p[i], 2 * j + 1));
+                b_[i].emplace_back(plane(p[i], 2 * j));
+            }
+        }
+        bit_sliced_and<T>(aby3_ctx().get(), tensor_factory().get(),
+                          num_blocks, a_, b_, z);
+
+        for (size_t i = 0; i < 2; ++i) {
+            std::vector<block> g_((m - h) * num_blocks);
+            std::vector<block> p_((m - h) * num_blocks);
+            for (size_t j = 0; j < h; ++j) {
+                std::transform(plane(g[i], 2 * j + 1),
+                               plane(g[i], 2 * j + 2),
+                               plane(z[i], j), g_.begin() + j * num_blocks,
+                               xor_);
+            }
+            std::copy(z[i].begin() + h * num_blocks, z[i].end(),
+                      p_.begin() + num_blocks);
+            if (m % 2) {
+                std::copy(plane(g[i], m - 1), plane(g[i], m),
+                          g_.begin() + h * num_blocks);
+                std::copy(plane(p[i], m - 1), plane(p[i], m),
+                          p_.begin() + h * num_blocks);
+            }
+            g[i].swap(g_);
+            p[i].swap(p_);
+        }
+    }
+
+    // msb = x_msb ^ y_msb ^ carry, to bit 0
+    uint64_t bits[2];
+    for (size_t i = 0; i < 2; ++i) {
+        T* out = ret->share(i)->data();
+        for (size_t b = 0; b < num_blocks; ++b) {
+            block c = xor_(xor_(plane(x[i], n)[b], plane(y[i], n)[b]),
+                           g[i][b]);
+            _mm_storeu_si128(reinterpret_cast<block*>(bits), c);
+            for (size_t r = 0; r < 128 && b * 128 + r < numel; ++r) {
+                out[b * 128 + r] = (bits[r / 64] >> (r % 64)) & 1;
+            }
+        }
+    }
+}
+
 template<typename T>
 void BooleanTensor<T>::ppa(const BooleanTensor* rhs,
                            BooleanTensor* ret,
                            size_t n_bits) const {
+    if (sizeof(T) == 8 && ret->numel() >= BIT_SLICE_BATCH) {
+        ppa_bit_sliced(rhs, ret, n_bits);
+        return;
+    }
     // kogge stone adder from tfe
     // https://github.com/tf-encrypted
     // TODO: check T is int64_t other native type not support yet
@@ -268,26 +651,13 @@ void BooleanTensor<T>::ppa(const BooleanTensor* rhs,
     c.bitwise_xor(&p, ret);
 }
 
+// boolean shares lhs of x0 + x1 and rhs of x2, in which a = x0 + x1 + x2
+// lhs and rhs are set to 0 by caller
 template<typename T, size_t N>
-void a2b(AbstractContext* aby3_ctx,
-         TensorAdapterFactory* tensor_factory,
-         const FixedPointTensor<T, N>* a,
-         BooleanTensor<T>* b,
-         size_t n_bits) {
-
-    std::shared_ptr<TensorAdapter<T>> tmp[4];
-    for (auto& ti: tmp) {
-        ti = tensor_factory->template create<T>(a->shape());
-        // set 0
-        std::transform(ti->data(), ti->data() + ti->numel(), ti->data(),
-                       [](T) -> T { return 0; });
-    }
-
-    std::shared_ptr<BooleanTensor<T>> lhs =
-            std::make_shared<BooleanTensor<T>>(tmp[0].get(), tmp[1].get());
-    std::shared_ptr<BooleanTensor<T>> rhs =
-            std::make_shared<BooleanTensor<T>>(tmp[2].get(), tmp[3].get());
-
+void a2b_operands(AbstractContext* aby3_ctx,
+                  const FixedPointTensor<T, N>* a,
+                  BooleanTensor<T>* lhs,
+                  BooleanTensor<T>* rhs) {
     if (aby3_ctx->party() == 0) {
         a->share(0)->add(a->share(1), lhs->share(0));
 
@@ -295,14 +665,9 @@ void a2b(AbstractContext* aby3_ctx,
         aby3_ctx->template gen_zero_sharing_boolean(*lhs->share(1));
         lhs->share(0)->bitwise_xor(lhs->share(1), lhs->share(0));
 
-        aby3_ctx->network()->template send(2, *(lhs->share(0)));
-        aby3_ctx->network()->template recv(1, *(lhs->share(1)));
-
     } else if (aby3_ctx->party() == 1) {
 
         aby3_ctx->template gen_zero_sharing_boolean(*lhs->share(0));
-        aby3_ctx->network()->template send(0, *(lhs->share(0)));
-        aby3_ctx->network()->template recv(2, *(lhs->share(1)));
 
         a->share(1)->copy(rhs->share(1));
 
@@ -310,12 +675,38 @@ void a2b(AbstractContext* aby3_ctx,
 
         aby3_ctx->template gen_zero_sharing_boolean(*lhs->share(0));
 
-        aby3_ctx->network()->template recv(0, *(lhs->share(1)));
-        aby3_ctx->network()->template send(1, *(lhs->share(0)));
-
         a->share(0)->copy(rhs->share(0));
     }
 
+    // send to pre party and recv from next party in one round
+    aby3_ctx->network()->template send_recv(aby3_ctx->pre_party(),
+                                            *(lhs->share(0)),
+                                            aby3_ctx->next_party(),
+                                            *(lhs->share(1)));
+}
+
+template<typename T, size_t N>
+void a2b(AbstractContext* aby3_ctx,
+         TensorAdapterFactory* tensor_factory,
+         const FixedPointTensor<T, N>* a,
+         BooleanTensor<T>* b,
+         size_t n_bits) {
+
+    std::shared_ptr<TensorAdapter<T>> tmp[4];
+    for (auto& ti: tmp) {
+        ti = tensor_factory->template create<T>(a->shape());
+        // set 0
+        std::transform(ti->data(), ti->data() + ti->numel(), ti->data(),
+                       [](T) -> T { return 0; });
+    }
+
+    std::shared_ptr<BooleanTensor<T>> lhs =
+            std::make_shared<BooleanTensor<T>>(tmp[0].get(), tmp[1].get());
+    std::shared_ptr<BooleanTensor<T>> rhs =
+            std::make_shared<BooleanTensor<T>>(tmp[2].get(), tmp[3].get());
+
+    a2b_operands(aby3_ctx, a, lhs.get(), rhs.get());
+
     lhs->ppa(rhs.get(), b, n_bits);
 }
 
@@ -337,6 +728,10 @@ void tensor_rshift_transform(const TensorAdapter<T>* lhs,
 template<typename T>
 template<size_t N>
 void BooleanTensor<T>::bit_extract(size_t i, const FixedPointTensor<T, N>* in) {
+    if (sizeof(T) == 8 && i == sizeof(T) * 8 - 1) {
+        msb(in);
+        return;
+    }
     a2b(aby3_ctx().get(), tensor_factory().get(), in, this, i + 1);
 
     tensor_rshift_transform(share(0), i, share(0));
@@ -349,6 +744,59 @@ void BooleanTensor<T>::bit_extract(size_t i, BooleanTensor* ret) const {
     tensor_rshift_transform(share(1), i, ret->share(1));
 }
 
+template<typename T>
+template<size_t N>
+void BooleanTensor<T>::msb(const FixedPointTensor<T, N>* in) {
+    msb(std::vector<const FixedPointTensor<T, N>*>{ in },
+        std::vector<BooleanTensor*>{ this });
+}
+
+template<typename T>
+template<size_t N>
+void BooleanTensor<T>::msb(
+    const std::vector<const FixedPointTensor<T, N>*>& in,
+    const std::vector<BooleanTensor*>& ret) {
+    PADDLE_ENFORCE_EQ(in.size(), ret.size(),
+                      "Input and output size not match.");
+    PADDLE_ENFORCE_EQ(sizeof(T), 8,
+                      "Only 64-bit elements are supported by msb.");
+
+    // all inputs are stacked into one circuit
+    size_t numel = 0;
+    for (auto t : in) {
+        numel += t->numel();
+    }
+    auto tmp = tensor_factory()->template malloc_tensor<T>(
+        6, std::vector<size_t>{ numel });
+    size_t offset = 0;
+    for (auto t : in) {
+        for (size_t i = 0; i < 2; ++i) {
+            std::copy(t->share(i)->data(), t->share(i)->data() + t->numel(),
+                      tmp[i]->data() + offset);
+        }
+        offset += t->numel();
+    }
+    for (size_t i = 2; i < 6; ++i) {
+        assign_to_tensor(tmp[i].get(), T(0));
+    }
+    FixedPointTensor<T, N> x(tmp[0].get(), tmp[1].get());
+    BooleanTensor lhs(tmp[2].get(), tmp[3].get());
+    BooleanTensor rhs(tmp[4].get(), tmp[5].get());
+
+    a2b_operands(aby3_ctx().get(), &x, &lhs, &rhs);
+    lhs.msb_bit_sliced(&rhs, &lhs);
+
+    offset = 0;
+    for (auto t : ret) {
+        for (size_t i = 0; i < 2; ++i) {
+            std::copy(lhs.share(i)->data() + offset,
+                      lhs.share(i)->data() + offset + t->numel(),
+                      t->share(i)->data());
+        }
+        offset += t->numel();
+    }
+}
+
 template<typename T>
 template<size_t N>
 void BooleanTensor<T>::b2a(FixedPointTensor<T, N>* ret) const {
@@ -525,8 +973,8 @@ void BooleanTensor<T>::onehot_from_cmp() {
         share(1)->slice(i - 1, i, tmp[5].get());
         BooleanTensor cmp_i(tmp[4].get(), tmp[5].get());
         found.bitwise_not(&not_found);
-        not_found.bitwise_and(&cmp_i, &cmp_i);
-        cmp_i.bitwise_or(&found, &found);
+        not_found.bit_and(&cmp_i, &cmp_i);
+        cmp_i.bit_or(&found, &found);
     }
 }
 } // namespace aby3
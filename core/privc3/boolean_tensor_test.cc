@@ -14,6 +14,7 @@
 
 #include <algorithm>
 #include <memory>
+#include <random>
 #include <thread>
 
 #include "gtest/gtest.h"
@@ -28,7 +29,7 @@
 #include "fixedpoint_tensor.h"
 #include "core/common/paddle_tensor.h"
 #include "aby3_context.h"
-#include "core/paddlefl_mpc/mpc_protocol/network/mesh_network.h"
+#include "core/paddlefl_mpc/mpc_protocol/network/mesh_network_shm.h"
 
 namespace aby3 {
 
@@ -42,8 +43,6 @@ public:
     std::shared_ptr<paddle::framework::ExecutionContext> _exec_ctx;
     std::shared_ptr<AbstractContext> _mpc_ctx[3];
 
-    std::shared_ptr<gloo::rendezvous::HashStore> _store;
-
     std::thread _t[3];
 
     std::shared_ptr<TensorAdapterFactory> _tensor_factory;
@@ -58,8 +57,6 @@ public:
         _exec_ctx = std::make_shared<paddle::framework::ExecutionContext>(
             *op, scope, _cpu_ctx, ctx);
 
-        _store = std::make_shared<gloo::rendezvous::HashStore>();
-
         std::thread t[3];
         for (size_t i = 0; i < 3; ++i) {
             _t[i] = std::thread(&BooleanTensorTest::gen_mpc_ctx, this, i);
@@ -72,13 +69,8 @@ public:
         _tensor_factory = std::make_shared<PaddleTensorFactory>(&_cpu_ctx);
     }
 
-    std::shared_ptr<paddle::mpc::MeshNetwork> gen_network(size_t idx) {
-
-        return std::make_shared<paddle::mpc::MeshNetwork>(idx,
-                                                          "127.0.0.1",
-                                                          3,
-                                                          "test_prefix",
-                                                          _store);
+    std::shared_ptr<paddle::mpc::MeshNetworkShm> gen_network(size_t idx) {
+        return std::make_shared<paddle::mpc::MeshNetworkShm>(idx, 3, "test_prefix");
     }
 
     void gen_mpc_ctx(size_t idx) {
@@ -192,6 +184,44 @@ TEST_F(BooleanTensorTest, reveal2_test) {
     EXPECT_EQ(2 ^ 3 ^ 4, p[2]->data()[0]);
 }
 
+TEST_F(BooleanTensorTest, reveal_many_test) {
+    std::shared_ptr<TensorAdapter<int64_t>> s0[3] = { gen1(), gen1(), gen1() };
+    std::shared_ptr<TensorAdapter<int64_t>> s1[3] = { gen1(), gen1(), gen1() };
+    std::shared_ptr<TensorAdapter<int64_t>> p[6] = { gen1(), gen1(), gen1(),
+                                                     gen1(), gen1(), gen1() };
+
+    // lhs = 5 = 2 ^ 3 ^ 4
+    s0[0]->data()[0] = 2;
+    s0[1]->data()[0] = 3;
+    s0[2]->data()[0] = 4;
+
+    // rhs = 7 = 1 ^ 2 ^ 4
+    s1[0]->data()[0] = 1;
+    s1[1]->data()[0] = 2;
+    s1[2]->data()[0] = 4;
+
+    for (size_t i = 0; i < 3; ++i) {
+        _t[i] = std::thread(
+            [&, i] () {
+            ContextHolder::template run_with_context(
+                _exec_ctx.get(), _mpc_ctx[i], [&](){
+                    BTensor b0(s0[i].get(), s0[(i + 1) % 3].get());
+                    BTensor b1(s1[i].get(), s1[(i + 1) % 3].get());
+                    BTensor::reveal_many({&b0, &b1},
+                                         {p[2 * i].get(), p[2 * i + 1].get()});
+                });
+            }
+        );
+    }
+    for (auto &t: _t) {
+        t.join();
+    }
+    for (size_t i = 0; i < 3; ++i) {
+        EXPECT_EQ(5, p[2 * i]->data()[0]);
+        EXPECT_EQ(7, p[2 * i + 1]->data()[0]);
+    }
+}
+
 TEST_F(BooleanTensorTest, xor1_test) {
     std::shared_ptr<TensorAdapter<int64_t>> sl[3] = { gen1(), gen1(), gen1() };
     std::shared_ptr<TensorAdapter<int64_t>> sr[3] = { gen1(), gen1(), gen1() };
@@ -861,6 +891,80 @@ TEST_F(BooleanTensorTest, ppa_test) {
     EXPECT_EQ(5 + 7, p->data()[0]);
 }
 
+TEST_F(BooleanTensorTest, ppa_bit_sliced_test) {
+    // more than one batch of bit-planes, and not a multiple of it
+    const size_t numel = 2 * BIT_SLICE_BATCH + 44;
+    std::vector<size_t> shape = { numel };
+    std::shared_ptr<TensorAdapter<int64_t>> sl[3] = { gen(shape), gen(shape), gen(shape) };
+    std::shared_ptr<TensorAdapter<int64_t>> sr[3] = { gen(shape), gen(shape), gen(shape) };
+    std::shared_ptr<TensorAdapter<int64_t>> sout[6] = { gen(shape), gen(shape), gen(shape),
+                                                        gen(shape), gen(shape), gen(shape) };
+
+    std::mt19937_64 rng(0);
+    std::vector<int64_t> lhs(numel);
+    std::vector<int64_t> rhs(numel);
+    for (size_t i = 0; i < numel; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            sl[j]->data()[i] = rng();
+            sr[j]->data()[i] = rng();
+        }
+        lhs[i] = sl[0]->data()[i] ^ sl[1]->data()[i] ^ sl[2]->data()[i];
+        rhs[i] = sr[0]->data()[i] ^ sr[1]->data()[i] ^ sr[2]->data()[i];
+    }
+
+    auto p = gen(shape);
+
+    BTensor bl0(sl[0].get(), sl[1].get());
+    BTensor bl1(sl[1].get(), sl[2].get());
+    BTensor bl2(sl[2].get(), sl[0].get());
+
+    BTensor br0(sr[0].get(), sr[1].get());
+    BTensor br1(sr[1].get(), sr[2].get());
+    BTensor br2(sr[2].get(), sr[0].get());
+
+    BTensor bout0(sout[0].get(), sout[1].get());
+    BTensor bout1(sout[2].get(), sout[3].get());
+    BTensor bout2(sout[4].get(), sout[5].get());
+
+    const size_t nbits = 64;
+
+    _t[0] = std::thread(
+        [&] () {
+        ContextHolder::template run_with_context(
+            _exec_ctx.get(), _mpc_ctx[0], [&](){
+                bl0.ppa(&br0, &bout0, nbits);
+                bout0.reveal_to_one(0, p.get());
+            });
+        }
+    );
+
+    _t[1] = std::thread(
+        [&] () {
+        ContextHolder::template run_with_context(
+            _exec_ctx.get(), _mpc_ctx[1], [&](){
+                bl1.ppa(&br1, &bout1, nbits);
+                bout1.reveal_to_one(0, nullptr);
+            });
+        }
+    );
+
+    _t[2] = std::thread(
+        [&] () {
+        ContextHolder::template run_with_context(
+            _exec_ctx.get(), _mpc_ctx[2], [&](){
+                bl2.ppa(&br2, &bout2, nbits);
+                bout2.reveal_to_one(0, nullptr);
+            });
+        }
+    );
+    for (auto &t: _t) {
+        t.join();
+    }
+    for (size_t i = 0; i < numel; ++i) {
+        EXPECT_EQ(int64_t(uint64_t(lhs[i]) + uint64_t(rhs[i])), p->data()[i]);
+    }
+}
+
 using FTensor = FixedPointTensor<int64_t, 32u>;
 
 TEST_F(BooleanTensorTest, b2a_test) {
@@ -1524,4 +1628,142 @@ TEST_F(BooleanTensorTest, onehot_from_cmp_test) {
     EXPECT_EQ(1, p->data()[2]);
     EXPECT_EQ(0, p->data()[3]);
 }
+
+TEST_F(BooleanTensorTest, bit_and_test) {
+    // more than one packed word
+    std::vector<size_t> shape = {130};
+    std::shared_ptr<TensorAdapter<int64_t>> sl[3] = { gen(shape), gen(shape), gen(shape) };
+    std::shared_ptr<TensorAdapter<int64_t>> sr[3] = { gen(shape), gen(shape), gen(shape) };
+    std::shared_ptr<TensorAdapter<int64_t>> sout[6] =
+    { gen(shape), gen(shape), gen(shape), gen(shape), gen(shape), gen(shape) };
+
+    // only lsb is significant, high bits are garbage
+    for (size_t i = 0; i < 130; ++i) {
+        sl[0]->data()[i] = 2 * i;
+        sl[1]->data()[i] = 4 * i + (i & 1);
+        sl[2]->data()[i] = 6 * i;
+        sr[0]->data()[i] = 8 * i + ((i >> 1) & 1);
+        sr[1]->data()[i] = 6 * i;
+        sr[2]->data()[i] = 4 * i;
+    }
+
+    auto p = gen(shape);
+
+    BTensor bl0(sl[0].get(), sl[1].get());
+    BTensor bl1(sl[1].get(), sl[2].get());
+    BTensor bl2(sl[2].get(), sl[0].get());
+
+    BTensor br0(sr[0].get(), sr[1].get());
+    BTensor br1(sr[1].get(), sr[2].get());
+    BTensor br2(sr[2].get(), sr[0].get());
+
+    BTensor bout0(sout[0].get(), sout[1].get());
+    BTensor bout1(sout[2].get(), sout[3].get());
+    BTensor bout2(sout[4].get(), sout[5].get());
+
+    _t[0] = std::thread(
+        [&] () {
+        ContextHolder::template run_with_context(
+            _exec_ctx.get(), _mpc_ctx[0], [&](){
+                bl0.bit_and(&br0, &bout0);
+                bout0.reveal_to_one(0, p.get());
+            });
+        }
+    );
+
+    _t[1] = std::thread(
+        [&] () {
+        ContextHolder::template run_with_context(
+            _exec_ctx.get(), _mpc_ctx[1], [&](){
+                bl1.bit_and(&br1, &bout1);
+                bout1.reveal_to_one(0, nullptr);
+            });
+        }
+    );
+
+    _t[2] = std::thread(
+        [&] () {
+        ContextHolder::template run_with_context(
+            _exec_ctx.get(), _mpc_ctx[2], [&](){
+                bl2.bit_and(&br2, &bout2);
+                bout2.reveal_to_one(0, nullptr);
+            });
+        }
+    );
+    for (auto &t: _t) {
+        t.join();
+    }
+    for (size_t i = 0; i < 130; ++i) {
+        EXPECT_EQ(int64_t((i & 1) & ((i >> 1) & 1)), p->data()[i]);
+    }
+}
+
+TEST_F(BooleanTensorTest, bit_or_test) {
+    // more than one packed word
+    std::vector<size_t> shape = {130};
+    std::shared_ptr<TensorAdapter<int64_t>> sl[3] = { gen(shape), gen(shape), gen(shape) };
+    std::shared_ptr<TensorAdapter<int64_t>> sr[3] = { gen(shape), gen(shape), gen(shape) };
+    std::shared_ptr<TensorAdapter<int64_t>> sout[6] =
+    { gen(shape), gen(shape), gen(shape), gen(shape), gen(shape), gen(shape) };
+
+    // only lsb is significant, high bits are garbage
+    for (size_t i = 0; i < 130; ++i) {
+        sl[0]->data()[i] = 2 * i;
+        sl[1]->data()[i] = 4 * i + (i & 1);
+        sl[2]->data()[i] = 6 * i;
+        sr[0]->data()[i] = 8 * i + ((i >> 1) & 1);
+        sr[1]->data()[i] = 6 * i;
+        sr[2]->data()[i] = 4 * i;
+    }
+
+    auto p = gen(shape);
+
+    BTensor bl0(sl[0].get(), sl[1].get());
+    BTensor bl1(sl[1].get(), sl[2].get());
+    BTensor bl2(sl[2].get(), sl[0].get());
+
+    BTensor br0(sr[0].get(), sr[1].get());
+    BTensor br1(sr[1].get(), sr[2].get());
+    BTensor br2(sr[2].get(), sr[0].get());
+
+    BTensor bout0(sout[0].get(), sout[1].get());
+    BTensor bout1(sout[2].get(), sout[3].get());
+    BTensor bout2(sout[4].get(), sout[5].get());
+
+    _t[0] = std::thread(
+        [&] () {
+        ContextHolder::template run_with_context(
+            _exec_ctx.get(), _mpc_ctx[0], [&](){
+                bl0.bit_or(&br0, &bout0);
+                bout0.reveal_to_one(0, p.get());
+            });
+        }
+    );
+
+    _t[1] = std::thread(
+        [&] () {
+        ContextHolder::template run_with_context(
+            _exec_ctx.get(), _mpc_ctx[1], [&](){
+                bl1.bit_or(&br1, &bout1);
+                bout1.reveal_to_one(0, nullptr);
+            });
+        }
+    );
+
+    _t[2] = std::thread(
+        [&] () {
+        ContextHolder::template run_with_context(
+            _exec_ctx.get(), _mpc_ctx[2], [&](){
+                bl2.bit_or(&br2, &bout2);
+                bout2.reveal_to_one(0, nullptr);
+            });
+        }
+    );
+    for (auto &t: _t) {
+        t.join();
+    }
+    for (size_t i = 0; i < 130; ++i) {
+        EXPECT_EQ(int64_t((i & 1) | ((i >> 1) & 1)), p->data()[i]);
+    }
+}
 } // namespace aby3
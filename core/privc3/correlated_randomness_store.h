@@ -0,0 +1,168 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "paddle/fluid/platform/enforce.h"
+
+namespace aby3 {
+
+// fifo of preprocessed values
+template <typename T>
+class RandomnessQueue {
+public:
+  size_t size() const { return _data.size() - _pos; }
+
+  void push(const T* data, size_t num) {
+    // drop consumed values
+    _data.erase(_data.begin(), _data.begin() + _pos);
+    _pos = 0;
+    _data.insert(_data.end(), data, data + num);
+  }
+
+  void pop(T* data, size_t num) {
+    PADDLE_ENFORCE_LE(num, size(), "Not enough preprocessed randomness.");
+    std::copy(_data.begin() + _pos, _data.begin() + _pos + num, data);
+    _pos += num;
+  }
+
+  void save(std::ostream& os) const {
+    uint64_t num = size();
+    os.write(reinterpret_cast<const char*>(&num), sizeof(num));
+    os.write(reinterpret_cast<const char*>(_data.data() + _pos),
+             num * sizeof(T));
+  }
+
+  // append values saved by save()
+  void load(std::istream& is) {
+    uint64_t num = 0;
+    is.read(reinterpret_cast<char*>(&num), sizeof(num));
+    std::vector<T> data(num);
+    is.read(reinterpret_cast<char*>(data.data()), num * sizeof(T));
+    PADDLE_ENFORCE(is.good(), "Corrupted preprocessing file.");
+    push(data.data(), num);
+  }
+
+private:
+  std::vector<T> _data;
+  // first value not consumed
+  size_t _pos = 0;
+};
+
+// num of each kind of correlated randomness
+struct PreprocessingDemand {
+  // scaling factor -> num of truncation pairs
+  std::map<size_t, size_t> trunc_pairs;
+};
+
+// Correlated randomness of a party generated ahead of online ops:
+// truncation pairs (r, r / 2^scaling_factor) held as replicated shares.
+// values are consumed in order of generation, so all parties take the
+// same values as long as they push and pop the same nums, which holds
+// as ops run in lockstep.
+class CorrelatedRandomnessStore {
+public:
+  size_t trunc_pair_size(size_t scaling_factor) const {
+    auto iter = _trunc_pairs.find(scaling_factor);
+    if (iter == _trunc_pairs.end()) {
+      return 0;
+    }
+    return iter->second.r[0].size();
+  }
+
+  // r[i] and r_trunc[i] are share i of this party
+  void push_trunc_pairs(size_t scaling_factor, const int64_t* r[2],
+                        const int64_t* r_trunc[2], size_t num) {
+    auto& pairs = _trunc_pairs[scaling_factor];
+    for (int i = 0; i < 2; ++i) {
+      pairs.r[i].push(r[i], num);
+      pairs.r_trunc[i].push(r_trunc[i], num);
+    }
+  }
+
+  void pop_trunc_pairs(size_t scaling_factor, size_t num, int64_t* r[2],
+                       int64_t* r_trunc[2]) {
+    _demand.trunc_pairs[scaling_factor] += num;
+    auto& pairs = _trunc_pairs[scaling_factor];
+    for (int i = 0; i < 2; ++i) {
+      pairs.r[i].pop(r[i], num);
+      pairs.r_trunc[i].pop(r_trunc[i], num);
+    }
+  }
+
+  // randomness asked for by online ops since last reset_demand(),
+  // whether served from store or not. run one step of a model and
+  // preprocess its demand times num of steps ahead of time
+  const PreprocessingDemand& demand() const { return _demand; }
+
+  void reset_demand() { _demand = PreprocessingDemand(); }
+
+  void save(const std::string& path) const {
+    std::ofstream os(path, std::ios::binary | std::ios::trunc);
+    PADDLE_ENFORCE(os.good(), "Failed to open preprocessing file: %s.", path);
+    uint64_t num = _trunc_pairs.size();
+    os.write(reinterpret_cast<const char*>(&num), sizeof(num));
+    for (auto& item : _trunc_pairs) {
+      uint64_t scaling_factor = item.first;
+      os.write(reinterpret_cast<const char*>(&scaling_factor),
+               sizeof(scaling_factor));
+      for (int i = 0; i < 2; ++i) {
+        item.second.r[i].save(os);
+        item.second.r_trunc[i].save(os);
+      }
+    }
+    PADDLE_ENFORCE(os.good(), "Failed to write preprocessing file: %s.", path);
+  }
+
+  // append randomness saved by save(), the file is removed after loaded
+  // for randomness must not be used twice
+  void load(const std::string& path) {
+    {
+      std::ifstream is(path, std::ios::binary);
+      PADDLE_ENFORCE(is.good(), "Failed to open preprocessing file: %s.",
+                     path);
+      uint64_t num = 0;
+      is.read(reinterpret_cast<char*>(&num), sizeof(num));
+      for (uint64_t n = 0; n < num; ++n) {
+        uint64_t scaling_factor = 0;
+        is.read(reinterpret_cast<char*>(&scaling_factor),
+                sizeof(scaling_factor));
+        auto& pairs = _trunc_pairs[scaling_factor];
+        for (int i = 0; i < 2; ++i) {
+          pairs.r[i].load(is);
+          pairs.r_trunc[i].load(is);
+        }
+      }
+    }
+    std::remove(path.c_str());
+  }
+
+private:
+  struct TruncPairs {
+    RandomnessQueue<int64_t> r[2];
+    RandomnessQueue<int64_t> r_trunc[2];
+  };
+
+  std::map<size_t, TruncPairs> _trunc_pairs;
+  PreprocessingDemand _demand;
+};
+
+} // namespace aby3
@@ -56,6 +56,10 @@ public:
     // reveal fixedpointtensor to all parties
     void reveal(TensorAdapter<T>* ret) const;
 
+    // reveal fixedpointtensors to all parties in one round
+    static void reveal_many(const std::vector<const FixedPointTensor*>& ins,
+                            const std::vector<TensorAdapter<T>*>& rets);
+
     const std::vector<size_t> shape() const;
 
     //convert TensorAdapter to shares
@@ -88,6 +92,12 @@ public:
     // element-wise mul with FixedPointTensor using truncate1
     void mul(const FixedPointTensor* rhs, FixedPointTensor* ret) const;
 
+    // batched mul, ret[i] = lhs[i] * rhs[i], all pairs in one round
+    // ret[i] may be the same as lhs[i] or rhs[i]
+    static void mul(const std::vector<const FixedPointTensor*>& lhs,
+                    const std::vector<const FixedPointTensor*>& rhs,
+                    const std::vector<FixedPointTensor*>& ret);
+
     // element-wise mul with TensorAdapter
     void mul(const TensorAdapter<T>* rhs, FixedPointTensor* ret) const;
 
@@ -104,9 +114,21 @@ public:
     void long_div(const FixedPointTensor* rhs,
                   FixedPointTensor* ret, size_t res_int_len = 20) const;
 
+    // div by normalizing abs(rhs) into [0.5, 1) with its bit decomposition
+    // and goldschmidt iterations, O(log(N)) rounds in total
+    // abs(rhs) should be in [2^-N, 2^N), or result is 0
+    void goldschmidt_div(const FixedPointTensor* rhs,
+                         FixedPointTensor* ret) const;
+
     void inverse_square_root(FixedPointTensor* ret,
                              size_t iter = 16, double x0 = 0x1p-10) const;
 
+    // inverse square root by normalizing this into [0.25, 1) with its
+    // bit decomposition, then a polynomial initial value refined by
+    // 2 newton steps (for N = 16). this should be at least 2^-N,
+    // result is 0 if this >= 2^(2N) for it is below 2^-N
+    void inverse_square_root_normalized(FixedPointTensor* ret) const;
+
     // dot_mul
     template<template<typename U, size_t...> class CTensor,
             size_t... N1>
@@ -131,6 +153,13 @@ public:
     // where n = 2^ite
     void exp(FixedPointTensor* ret, size_t iter = 8) const;
 
+    // exp by splitting x * log2(e) into integer and fractional parts,
+    // 2^integer by its secure bits and 2^fraction by a polynomial,
+    // in about 13 rounds with error of a few ulps. e^x = 0 if
+    // x * log2(e) < -2^K and e^x = 2^(2^K) if x * log2(e) >= 2^K,
+    // for K = floor(log2(N))
+    void exp_split(FixedPointTensor* ret) const;
+
     // element-wise relu
     void relu(FixedPointTensor* ret) const;
 
@@ -149,20 +178,33 @@ public:
     // implemented with ref to tfe[https://github.com/tf-encrypted/tf-encrypted]
     void sigmoid_chebyshev(FixedPointTensor* ret) const;
 
-    // element-wise sigmoid using long-div and exp
+    // element-wise sigmoid using goldschmidt div and exp
     // higher precision but higher time cost
     void sigmoid_high_precision(FixedPointTensor<T, N>* ret) const;
 
+    // sigmoid_high_precision using exp_split
+    void sigmoid_high_precision_split(FixedPointTensor<T, N>* ret) const;
+
     // softmax axis = -1
+    // use_long_div: divide by long_div for high precision,
+    // otherwise by newton's reciprocal
+    // use_goldschmidt_div: divide by goldschmidt_div in O(log(N)) rounds
+    // instead, for exp only. sum of relu is unbounded and always
+    // divided as use_long_div says
+    // use_split_exp: exp by exp_split, otherwise by exp
     void softmax(FixedPointTensor* ret,
                  bool use_relu = false,
-                 bool use_long_div = true) const;
+                 bool use_long_div = true,
+                 bool use_goldschmidt_div = false,
+                 bool use_split_exp = false) const;
 
-    // element-wise polynomial
+    // element-wise polynomial in ceil(log2(degree)) + 1 rounds
     void polynomial(const TensorAdapter<T>* coeff,
                     FixedPointTensor* ret) const;
 
-    // element-wise piecewise polynomial
+    // element-wise piecewise polynomial, break points in ascending order,
+    // enforced as they are public.
+    // all pieces are compared and evaluated in one batch
     void polynomial_piecewise(
                 const TensorAdapter<T>* coeff,
                 const TensorAdapter<T>* break_point,
@@ -189,6 +231,12 @@ public:
             size_t... N1>
     void geq(const CTensor<T, N1...>* rhs, BooleanTensor<T>* ret) const;
 
+    // batched <, ret[i] = lhs[i] < rhs[i]
+    // all pairs are compared in one run of the msb circuit
+    static void lt(const std::vector<const FixedPointTensor*>& lhs,
+                   const std::vector<const FixedPointTensor*>& rhs,
+                   const std::vector<BooleanTensor<T>*>& ret);
+
     // ==
     template<template<typename U, size_t...> class CTensor,
             size_t... N1>
@@ -210,7 +258,8 @@ public:
     // for tensor with shape like [k, n, m, ...]
     // ret shape is [1, n, m, ...], in which every element is largest of k elements
     // pos shape is [k, n, m, ...], each col of pos is an one-hot tensor
-    // which indicating the max element's position
+    // which indicating the max element's position (the first one if tied)
+    // elements are reduced pairwise in ceil(log2(k)) levels of comparison
     void max_pooling(FixedPointTensor* ret,
                      BooleanTensor<T>* pos = nullptr) const;
 
@@ -231,6 +280,17 @@ public:
     static void truncate(const FixedPointTensor* op, FixedPointTensor* ret,
                         size_t scaling_factor);
 
+    // preprocessing of truncation: generate num truncation pairs in one round.
+    // mul and truncate consume one pair per element of result, and
+    // generate pairs on demand if not enough
+    static void preprocess_trunc_pairs(size_t num, size_t scaling_factor = N);
+
+    // generate randomness of demand times num_steps into store of current
+    // context ahead of online ops, all parties call it together.
+    // demand of a model step can be read from store after running it
+    static void preprocess(const PreprocessingDemand& demand,
+                           size_t num_steps = 1);
+
 private:
     static inline std::shared_ptr<AbstractContext> aby3_ctx() {
       return paddle::mpc::ContextHolder::mpc_ctx();
@@ -240,11 +300,34 @@ private:
         return paddle::mpc::ContextHolder::tensor_factory();
     }
 
-    template<typename MulFunc>
-    static void mul_trunc(const FixedPointTensor<T, N>* lhs,
-                          const FixedPointTensor<T, N>* rhs,
-                          FixedPointTensor<T, N>* ret,
-                          MulFunc mul_func);
+    static ABY3Context* aby3_context();
+
+    static CorrelatedRandomnessStore& store() {
+        return aby3_context()->store();
+    }
+
+    // truncate z of 3-out-of-3 sharing into ret in one round,
+    // using a truncation pair. z is overwritten
+    static void truncate_masked(TensorAdapter<T>* z, FixedPointTensor* ret,
+                                size_t scaling_factor);
+
+    // mul truncated by scaling_factor instead of N, a product
+    // beyond 2^(2N) before truncation should be non-negative
+    void mul(const FixedPointTensor* rhs, FixedPointTensor* ret,
+             size_t scaling_factor) const;
+
+    // ret = public value of raw, held as x_0
+    static void assign_public(T raw, FixedPointTensor* ret);
+
+    // sigmoid = 1 / (1 + exp_neg), exp_neg = e^-x
+    static void sigmoid_by_exp(const FixedPointTensor* exp_neg,
+                               FixedPointTensor* ret);
+
+    // for msb j of x >= 0, out[i] = weights[i][j] if j < weights[i].size()
+    // else 0, all looked up by one-hot of j in one batched ab mul
+    static void lookup_msb(const FixedPointTensor* x,
+                           const std::vector<std::vector<T>>& weights,
+                           const std::vector<FixedPointTensor*>& out);
 
     // truncate3 protocol can avoid losing msb error when truncate
     // with acceptable security compromise
@@ -267,15 +350,11 @@ private:
         return aby3_ctx()->next_party();
     }
 
+    // send to pre party and recv from next party in one round
     static void reshare(const TensorAdapter<T>* send_val,
                  TensorAdapter<T>* recv_val) {
-        if (party() == 0) {
-            aby3_ctx()->network()->template recv(next_party(), *recv_val);
-            aby3_ctx()->network()->template send(pre_party(), *send_val);
-        } else {
-            aby3_ctx()->network()->template send(pre_party(), *send_val);
-            aby3_ctx()->network()->template recv(next_party(), *recv_val);
-        }
+        aby3_ctx()->network()->template send_recv(pre_party(), *send_val,
+                                                  next_party(), *recv_val);
     }
 
     static void reciprocal(const FixedPointTensor* op, FixedPointTensor* ret,
@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <algorithm>
 
@@ -72,8 +73,55 @@ void FixedPointTensor<T, N>::reveal_to_one(size_t party,
 // reveal fixedpointtensor to all parties
 template<typename T, size_t N>
 void FixedPointTensor<T, N>::reveal(TensorAdapter<T>* ret) const {
-    for (size_t i = 0; i < 3; ++i) {
-        reveal_to_one(i, ret);
+    // every party sends share 0 to next party and
+    // receives the missing share from pre party at the same time
+    auto buffer = tensor_factory()->template create<T>(ret->shape());
+    aby3_ctx()->network()->template send_recv(next_party(), *share(0),
+                                              pre_party(), *buffer);
+
+    share(0)->add(buffer.get(), ret);
+    share(1)->add(ret, ret);
+    ret->scaling_factor() = N;
+}
+
+// reveal fixedpointtensors to all parties in one round
+template<typename T, size_t N>
+void FixedPointTensor<T, N>::reveal_many(
+    const std::vector<const FixedPointTensor*>& ins,
+    const std::vector<TensorAdapter<T>*>& rets) {
+    PADDLE_ENFORCE_EQ(ins.size(), rets.size(),
+                      "Num of inputs and outputs should be equal.");
+    size_t numel = 0;
+    for (auto in : ins) {
+        numel += in->share(0)->numel();
+    }
+
+    // share 0 of all tensors in one msg
+    std::vector<T> send_buf(numel);
+    std::vector<T> recv_buf(numel);
+    T* ptr = send_buf.data();
+    for (auto in : ins) {
+        ptr = std::copy(in->share(0)->data(),
+                        in->share(0)->data() + in->share(0)->numel(), ptr);
+    }
+
+    aby3_ctx()->network()->send_recv(next_party(), send_buf.data(),
+                                     numel * sizeof(T), pre_party(),
+                                     recv_buf.data(), numel * sizeof(T));
+
+    const T* missing = recv_buf.data();
+    for (size_t i = 0; i < ins.size(); ++i) {
+        const size_t n = ins[i]->share(0)->numel();
+        PADDLE_ENFORCE_EQ(rets[i]->numel(), n,
+                          "Shape of input and output should be equal.");
+        const T* s0 = ins[i]->share(0)->data();
+        const T* s1 = ins[i]->share(1)->data();
+        T* ret = rets[i]->data();
+        for (size_t j = 0; j < n; ++j) {
+            ret[j] = s0[j] + s1[j] + missing[j];
+        }
+        missing += n;
+        rets[i]->scaling_factor() = N;
     }
 }
 
@@ -108,47 +156,34 @@ void FixedPointTensor<T, N>::share(const TensorAdapter<T>* input,
 
 //convert TensorAdapter to shares and distribute to all parties
 template<typename T, size_t N>
-void FixedPointTensor<T, N>::online_share(const size_t party, 
+void FixedPointTensor<T, N>::online_share(const size_t party,
                                           const TensorAdapter<T>* input,
                                           FixedPointTensor<T, N>* ret) {
-    // create a tensor which contains two shares to send/recv   
-    auto shape = input->shape();
-    std::vector<size_t> shape_ = shape;
-    shape_.insert(shape_.begin(), 2);
-    auto one_party_shares = tensor_factory()->template create<T>(shape_);
-
+    // shares x = s0 + s1 + s2, where party holds (s0, s1),
+    // next party holds (s1, s2) and pre party holds (s2, s0).
+    // s0 and s1 are drawn from prngs that party shares with
+    // pre party and next party respectively, so only s2 is sent
     if (party == FixedPointTensor::party()) {
-        // this party has original data: 
-        // encrypt input into 3 shares
-        auto temp = tensor_factory()->template malloc_tensor<T>(3, input->shape());
-        TensorAdapter<T>* shares[3]{temp[0].get(), temp[1].get(), temp[2].get()};
-        share(input, shares);
-
-        // share 0&1
-        shares[0]->copy(ret->_share[0]);
-        shares[1]->copy(ret->_share[1]);
- 
-        // send share 1&2 to next_party 
-        std::copy(shares[1]->data(), shares[1]->data() + shares[1]->numel(),
-                  one_party_shares.get()->data());
-        std::copy(shares[2]->data(), shares[2]->data() + shares[2]->numel(), 
-                  one_party_shares.get()->data() + shares[1]->numel());
-        aby3_ctx()->network()->template send(next_party(), *one_party_shares);
-        
-        // send share 2&0 to pre_party
-        std::copy(shares[2]->data(), shares[2]->data() + shares[2]->numel(), 
-                  one_party_shares.get()->data());
-        std::copy(shares[0]->data(), shares[0]->data() + shares[0]->numel(), 
-                  one_party_shares.get()->data() + shares[2]->numel());
-        aby3_ctx()->network()->template send(pre_party(), *one_party_shares);
+        // s0 from prng shared with pre party
+        aby3_ctx()->template gen_random(*ret->_share[0], false);
+        // s1 from prng shared with next party
+        aby3_ctx()->template gen_random(*ret->_share[1], true);
+
+        auto s2 = tensor_factory()->template create<T>(input->shape());
+        ret->_share[0]->add(ret->_share[1], s2.get());
+        input->sub(s2.get(), s2.get());
+
+        auto send_next = aby3_ctx()->network()->isend(next_party(), *s2);
+        aby3_ctx()->network()->template send(pre_party(), *s2);
+        send_next->wait();
+    } else if (party == pre_party()) {
+        // this is next party of owner, holding (s1, s2)
+        aby3_ctx()->template gen_random(*ret->_share[0], false);
+        aby3_ctx()->network()->template recv(party, *ret->_share[1]);
     } else {
-        // recv share from 'party' who has original data
-        aby3_ctx()->network()->template recv(party, *(one_party_shares));
-        std::copy(one_party_shares->data(), one_party_shares->data() + one_party_shares->numel() / 2, 
-                  ret->_share[0]->data());
-        std::copy(one_party_shares->data() + one_party_shares->numel() / 2, 
-                  one_party_shares->data() + one_party_shares->numel(),
-                  ret->_share[1]->data());
+        // this is pre party of owner, holding (s2, s0)
+        aby3_ctx()->network()->template recv(party, *ret->_share[0]);
+        aby3_ctx()->template gen_random(*ret->_share[1], true);
     }
 }
 
@@ -206,15 +241,85 @@ void FixedPointTensor<T, N>::negative(FixedPointTensor<T, N>* ret) const {
     _share[1]->negative(ret->_share[1]);
 }
 
+// Multiply with truncation in one round.
+// each party i holds z_i of 3-out-of-3 sharing of z = lhs * rhs,
+// masked by a zero sharing, which is truncated as is.
 template<typename T, size_t N>
 void FixedPointTensor<T, N>::mul(const FixedPointTensor<T, N>* rhs,
                                  FixedPointTensor<T, N>* ret) const {
-    mul_trunc(this, rhs, ret, [](
-            const TensorAdapter<T>* lhs,
-            const TensorAdapter<T>* rhs,
-            TensorAdapter<T>* ret) {
-        lhs->mul(rhs, ret);
-        });
+    mul(rhs, ret, N);
+}
+
+template<typename T, size_t N>
+void FixedPointTensor<T, N>::mul(const FixedPointTensor<T, N>* rhs,
+                                 FixedPointTensor<T, N>* ret,
+                                 size_t scaling_factor) const {
+    PADDLE_ENFORCE_EQ(numel(), rhs->numel(), "Input numel should be equal.");
+    PADDLE_ENFORCE_EQ(numel(), ret->numel(),
+                      "Input and output numel should be equal.");
+
+    auto z = tensor_factory()->template create<T>(ret->shape());
+    aby3_ctx()->gen_zero_sharing_arithmetic(*z.get());
+
+    // z += a0 * (b0 + b1) + a1 * b0, fused in one pass
+    const T* a0 = _share[0]->data();
+    const T* a1 = _share[1]->data();
+    const T* b0 = rhs->_share[0]->data();
+    const T* b1 = rhs->_share[1]->data();
+    T* z_ = z->data();
+    const size_t n = numel();
+    for (size_t i = 0; i < n; ++i) {
+        z_[i] += a0[i] * (b0[i] + b1[i]) + a1[i] * b0[i];
+    }
+
+    truncate_masked(z.get(), ret, scaling_factor);
+}
+
+template<typename T, size_t N>
+void FixedPointTensor<T, N>::mul(const std::vector<const FixedPointTensor*>& lhs,
+                                 const std::vector<const FixedPointTensor*>& rhs,
+                                 const std::vector<FixedPointTensor*>& ret) {
+    PADDLE_ENFORCE_EQ(lhs.size(), rhs.size(),
+                      "Input and output size not match.");
+    PADDLE_ENFORCE_EQ(lhs.size(), ret.size(),
+                      "Input and output size not match.");
+    size_t numel = 0;
+    for (auto t : lhs) {
+        numel += t->numel();
+    }
+    auto buf = tensor_factory()->template malloc_tensor<T>(
+        6, std::vector<size_t>{ numel });
+    FixedPointTensor lhs_(buf[0].get(), buf[1].get());
+    FixedPointTensor rhs_(buf[2].get(), buf[3].get());
+    FixedPointTensor ret_(buf[4].get(), buf[5].get());
+
+    size_t offset = 0;
+    for (size_t k = 0; k < lhs.size(); ++k) {
+        const size_t n = lhs[k]->numel();
+        PADDLE_ENFORCE_EQ(n, rhs[k]->numel(), "Input numel should be equal.");
+        PADDLE_ENFORCE_EQ(n, ret[k]->numel(),
+                          "Input and output numel should be equal.");
+        for (size_t i = 0; i < 2; ++i) {
+            std::copy(lhs[k]->share(i)->data(), lhs[k]->share(i)->data() + n,
+                      buf[i]->data() + offset);
+            std::copy(rhs[k]->share(i)->data(), rhs[k]->share(i)->data() + n,
+                      buf[2 + i]->data() + offset);
+        }
+        offset += n;
+    }
+
+    lhs_.mul(&rhs_, &ret_);
+
+    offset = 0;
+    for (auto t : ret) {
+        const size_t n = t->numel();
+        for (size_t i = 0; i < 2; ++i) {
+            std::copy(buf[4 + i]->data() + offset,
+                      buf[4 + i]->data() + offset + n,
+                      t->mutable_share(i)->data());
+        }
+        offset += n;
+    }
 }
 
 #ifdef USE_ABY3_TRUNC1 //use aby3 trunc1
@@ -274,13 +379,9 @@ void FixedPointTensor<T, N>::truncate(const FixedPointTensor<T, N>* op,
 // and r' in Z_{2^64} is equal to |X| / (2^63 + |X|)
 
 // detail protocol:
-// P2 randomly generates r' \in (-2^62, 2^62), randomly generates r'_0, r_0, r_1 in Z_{2^64},
-// P2 compute r'_1 = r' - r'_0, r_2 = r'/2^N - r_0 - r_1, let x2 = r_2
-// P2 send r_0, r'_0 to P0, send r_1, r'_1 to P1
-// P1 and P0 execute "reveal x - r' to P1"
-// P1 compute x1 = (x - r') / 2^N + r_1
-// P0 set x0 = r_0
-// P0, P1, P2 invoke reshare() with inputs x0, x1, x2 respectively.
+// P2 generates truncation pair (r', r'/2^N) in preprocessing, see preprocess_trunc_pairs.
+// P0, P1 open x - r' in one round with x_i - r'_i, see truncate_masked.
+// P0 and P1 add (x - r') / 2^N to x_1 of r'/2^N, which P2 does not hold.
 template<typename T, size_t N>
 void FixedPointTensor<T, N>::truncate(const FixedPointTensor<T, N>* op,
                                        FixedPointTensor<T, N>* ret,
@@ -290,114 +391,134 @@ void FixedPointTensor<T, N>::truncate(const FixedPointTensor<T, N>* op,
         op->share(1)->copy(ret->mutable_share(1));
         return;
     }
-    std::vector<std::shared_ptr<TensorAdapter<T>>> temp;
+    // x_i as 3-out-of-3 sharing
+    auto z = tensor_factory()->template create<T>(op->shape());
+    op->share(0)->copy(z.get());
+    truncate_masked(z.get(), ret, scaling_factor);
+}
+#endif //USE_ABY3_TRUNC1
+
+template<typename T, size_t N>
+ABY3Context* FixedPointTensor<T, N>::aby3_context() {
+    auto ctx = dynamic_cast<ABY3Context*>(aby3_ctx().get());
+    PADDLE_ENFORCE_NOT_NULL(ctx, "Preprocessing requires ABY3Context.");
+    return ctx;
+}
+
+// Generate truncation pairs (r, r / 2^sf), party 2 as dealer as in truncate3.
+// P2 randomly generates r \in (-2^62, 2^62), r_trunc = r / 2^sf,
+// and shares of both: x_0 with P0 and x_2 with P1 from common prngs,
+// x_1 = x - x_0 - x_2 sent to P0 and P1.
+template<typename T, size_t N>
+void FixedPointTensor<T, N>::preprocess_trunc_pairs(size_t num,
+                                                    size_t scaling_factor) {
+    std::vector<size_t> shape = {num};
+    // share 0 and 1 of r, share 0 and 1 of r_trunc
+    auto s = tensor_factory()->template malloc_tensor<T>(4, shape);
+
     if (party() == 2) {
-        for (int i = 0; i < 7; ++i) {
-            temp.emplace_back(
-                tensor_factory()->template create<T>(op->shape()));
+        auto r = tensor_factory()->template create<T>(shape);
+        auto r_trunc = tensor_factory()->template create<T>(shape);
+        aby3_ctx()->template gen_random_private(*r);
+        r->rshift(1, r.get());
+        r->rshift(scaling_factor, r_trunc.get());
+
+        // P2 holds (x_2, x_0)
+        aby3_ctx()->template gen_random(*s[1], true);
+        aby3_ctx()->template gen_random(*s[3], true);
+        aby3_ctx()->template gen_random(*s[0], false);
+        aby3_ctx()->template gen_random(*s[2], false);
+
+        r->sub(s[0].get(), r.get());
+        r->sub(s[1].get(), r.get());
+        r_trunc->sub(s[2].get(), r_trunc.get());
+        r_trunc->sub(s[3].get(), r_trunc.get());
+
+        std::vector<std::shared_ptr<paddle::mpc::AsyncHandle>> handles;
+        for (size_t p = 0; p < 2; ++p) {
+            handles.emplace_back(aby3_ctx()->network()->isend(p, *r));
+            handles.emplace_back(aby3_ctx()->network()->isend(p, *r_trunc));
         }
-        // r'
-        aby3_ctx()->template gen_random_private(*temp[0]);
-        temp[0]->rshift(1, temp[0].get());
-
-        //r'_0, r'_1
-        aby3_ctx()->template gen_random_private(*temp[1]);
-        temp[0]->sub(temp[1].get(), temp[2].get());
-        // r, r_0, r_1
-        temp[0]->rshift(scaling_factor, temp[3].get());
-        aby3_ctx()->template gen_random_private(*temp[4]);
-        aby3_ctx()->template gen_random_private(*temp[5]);
-        // r_2
-        temp[3]->sub(temp[4].get(), temp[6].get());
-        temp[6]->sub(temp[5].get(), temp[6].get());
-
-        aby3_ctx()->network()->template send(1, *temp[2]);
-        aby3_ctx()->network()->template send(1, *temp[5]);
-        aby3_ctx()->network()->template send(0, *temp[1]);
-        aby3_ctx()->network()->template send(0, *temp[4]);
-
-        temp[6]->copy(ret->mutable_share(0));
-
-    } else if (party() == 1) {
-        for (int i = 0; i < 4; ++i) {
-            temp.emplace_back(
-                tensor_factory()->template create<T>(op->shape()));
+        for (auto& handle : handles) {
+            handle->wait();
         }
-        // r'_1, r_1
-        aby3_ctx()->network()->template recv(2, *temp[0]);
-        aby3_ctx()->network()->template recv(2, *temp[1]);
-        // recv x0 - r'_0 from party 0
-        aby3_ctx()->network()->template recv(0, *temp[2]);
-        //reveal x - r' to party 1
-        op->share(0)->add(op->share(1), temp[3].get());
-        temp[3]->add(temp[2].get(), temp[3].get());
-        temp[3]->sub(temp[0].get(), temp[3].get());
-        // truncate x-r'
-        temp[3]->rshift(scaling_factor, temp[3].get());
-
-        temp[3]->add(temp[1].get(), ret->mutable_share(0));
+    } else if (party() == 0) {
+        // P0 holds (x_0, x_1)
+        aby3_ctx()->template gen_random(*s[0], false);
+        aby3_ctx()->template gen_random(*s[2], false);
+        aby3_ctx()->network()->template recv(2, *s[1]);
+        aby3_ctx()->network()->template recv(2, *s[3]);
     } else {
-        for (int i = 0; i < 3; ++i) {
-            temp.emplace_back(
-                tensor_factory()->template create<T>(op->shape()));
-        }
-        // r'_0, r_0
-        aby3_ctx()->network()->template recv(2, *temp[0]);
-        aby3_ctx()->network()->template recv(2, *temp[1]);
-        //send x0 - r'_0 to party 1
-        op->share(0)->sub(temp[0].get(), temp[2].get());
-        aby3_ctx()->network()->template send(1, *temp[2]);
-        temp[1]->copy(ret->mutable_share(0));
+        // P1 holds (x_1, x_2)
+        aby3_ctx()->template gen_random(*s[1], true);
+        aby3_ctx()->template gen_random(*s[3], true);
+        aby3_ctx()->network()->template recv(2, *s[0]);
+        aby3_ctx()->network()->template recv(2, *s[2]);
     }
 
-    reshare(ret->share(0), ret->mutable_share(1));
+    const T* r[2] = {s[0]->data(), s[1]->data()};
+    const T* r_trunc[2] = {s[2]->data(), s[3]->data()};
+    store().push_trunc_pairs(scaling_factor, r, r_trunc, num);
+}
 
-    // compensation for carry in
-    auto tensor_carry_in = tensor_factory()->template create<T>(ret->shape());
-    assign_to_tensor(tensor_carry_in.get(), (T)1);
-    tensor_carry_in->scaling_factor() = N;
-    ret->add(tensor_carry_in.get(), ret);
+template<typename T, size_t N>
+void FixedPointTensor<T, N>::preprocess(const PreprocessingDemand& demand,
+                                        size_t num_steps) {
+    for (auto& item : demand.trunc_pairs) {
+        preprocess_trunc_pairs(item.second * num_steps, item.first);
+    }
 }
-#endif //USE_ABY3_TRUNC1
 
+// As ABY3's preprocessed truncation, with a truncation pair (r, r / 2^sf),
+// P0 and P1 open z - r = sum(z_i - r_i) in one round: P2 sends to both,
+// P0 and P1 send to each other. P2 who knows r learns nothing of z - r.
+// then z / 2^sf = (z - r) / 2^sf + r / 2^sf, where the public part is
+// added to x_1 which P2 does not hold.
 template<typename T, size_t N>
-template<typename MulFunc>
-void FixedPointTensor<T, N>::mul_trunc(const FixedPointTensor<T, N>* lhs,
-                                        const FixedPointTensor<T, N>* rhs,
-                                        FixedPointTensor<T, N>* ret,
-                                        MulFunc mul_func) {
-
-    auto r_zero = tensor_factory()->template create<T>(ret->shape());
-    aby3_ctx()->gen_zero_sharing_arithmetic(*r_zero.get());
-
-    // temp = _share[0]->mul(rhs->_share[0]) +
-    //        _share[0]->mul(rhs->_share[1]) +
-    //        _share[1]->mul(rhs->_share[0]) +
-    //        r_zero
-    auto temp = tensor_factory()->template create<T>(ret->shape());
-    auto temp1 = tensor_factory()->template create<T>(ret->shape());
+void FixedPointTensor<T, N>::truncate_masked(TensorAdapter<T>* z,
+                                             FixedPointTensor<T, N>* ret,
+                                             size_t scaling_factor) {
+    const size_t numel = ret->numel();
+    auto available = store().trunc_pair_size(scaling_factor);
+    if (available < numel) {
+        preprocess_trunc_pairs(numel - available, scaling_factor);
+    }
 
-    // use mul_func to fit both element_wise mul and mat mul
-    mul_func(lhs->share(0), rhs->share(0), temp.get());
-    mul_func(lhs->share(0), rhs->share(1), temp1.get());
-    temp1->add(temp.get(), temp1.get());
+    auto temp = tensor_factory()->template malloc_tensor<T>(2, ret->shape());
 
-    mul_func(lhs->share(1), rhs->share(0), temp.get());
-    temp1->add(r_zero.get(), temp1.get());
-    temp->add(temp1.get(), temp.get());
+    // r to temp, r / 2^sf to ret
+    T* r[2] = {temp[0]->data(), temp[1]->data()};
+    T* r_trunc[2] = {ret->_share[0]->data(), ret->_share[1]->data()};
+    store().pop_trunc_pairs(scaling_factor, numel, r, r_trunc);
 
-    auto temp2 = tensor_factory()->template create<T>(ret->shape());
-    auto temp3 = tensor_factory()->template create<T>(ret->shape());
+    // z_i - r_i
+    z->sub(temp[0].get(), z);
+
+    if (party() == 2) {
+        auto send_0 = aby3_ctx()->network()->isend(0, *z);
+        aby3_ctx()->network()->template send(1, *z);
+        send_0->wait();
+        return;
+    }
 
-    TensorAdapter<int64_t>* temp_array[2] = {temp2.get(), temp3.get()};
+    auto other = party() == 0 ? 1 : 0;
+    auto send_other = aby3_ctx()->network()->isend(other, *z);
+    aby3_ctx()->network()->template recv(other, *temp[0]);
+    aby3_ctx()->network()->template recv(2, *temp[1]);
+    send_other->wait();
 
-    std::shared_ptr<FixedPointTensor<T, N>> ret_no_trunc =
-            std::make_shared<FixedPointTensor<T, N>>(temp_array);
+    // (z - r) / 2^sf
+    z->add(temp[0].get(), temp[0].get());
+    temp[0]->add(temp[1].get(), temp[0].get());
+    temp[0]->rshift(scaling_factor, temp[0].get());
 
-    temp->copy(ret_no_trunc->_share[0]);
-    reshare(temp.get(), ret_no_trunc->_share[1]);
+    // compensation for carry in, as truncate3
+    std::for_each(temp[0]->data(), temp[0]->data() + numel,
+                  [](T& val) { ++val; });
 
-    truncate(ret_no_trunc.get(), ret, N);
+    // x_1 is share 1 of P0 and share 0 of P1
+    auto x_1 = ret->_share[party() == 0 ? 1 : 0];
+    x_1->add(temp[0].get(), x_1);
 }
 
 template<typename T, size_t N>
@@ -450,12 +571,19 @@ void FixedPointTensor<T, N>::mat_mul(const FixedPointTensor<T, N>* rhs,
                                      FixedPointTensor<T, N>* ret,
                                      bool trans_lhs,
                                      bool trans_rhs) const {
-    mul_trunc(this, rhs, ret, [trans_lhs, trans_rhs](
-            const TensorAdapter<T>* lhs,
-            const TensorAdapter<T>* rhs,
-            TensorAdapter<T>* ret) {
-        lhs->mat_mul(rhs, ret, trans_lhs, trans_rhs);
-        });
+    auto z = tensor_factory()->template create<T>(ret->shape());
+    aby3_ctx()->gen_zero_sharing_arithmetic(*z.get());
+
+    // (a0 + a1) * b0 + a0 * b1, two mat_muls instead of three
+    auto lhs_sum = tensor_factory()->template create<T>(shape());
+    auto prod = tensor_factory()->template create<T>(ret->shape());
+    _share[0]->add(_share[1], lhs_sum.get());
+    lhs_sum->mat_mul(rhs->_share[0], prod.get(), trans_lhs, trans_rhs);
+    z->add(prod.get(), z.get());
+    _share[0]->mat_mul(rhs->_share[1], prod.get(), trans_lhs, trans_rhs);
+    z->add(prod.get(), z.get());
+
+    truncate_masked(z.get(), ret, N);
 }
 
 template<typename T, size_t N>
@@ -520,6 +648,189 @@ void FixedPointTensor<T, N>::exp(FixedPointTensor<T, N>* ret,
     }
 }
 
+template<typename T, size_t N>
+void FixedPointTensor<T, N>::assign_public(T raw, FixedPointTensor* ret) {
+    for (size_t i = 0; i < 2; ++i) {
+        const bool held = (party() == 0 && i == 0) || (party() == 2 && i == 1);
+        assign_to_tensor(ret->mutable_share(i), held ? raw : T(0));
+    }
+}
+
+template< typename T, size_t N>
+void FixedPointTensor<T, N>::exp_split(FixedPointTensor<T, N>* ret) const {
+    // e^x = 2^y = 2^floor(y) * 2^t, y = x * log2(e), t = y - floor(y).
+    // for y in [-2^K, 2^K) with bits b_i of its integer part and sign s,
+    // 2^floor(y) = prod(b_i ? 2^(2^i) : 1) * (s ? 2^-(2^K) : 1), all of
+    // which are exact, and the sign factor goes last so that no small
+    // value is scaled up
+    const size_t K = std::log2(N);
+    const size_t numel = this->numel();
+    const T one = T(1) << N;
+
+    auto log2e = tensor_factory()->template create<T>(shape());
+    assign_to_tensor(log2e.get(), T(std::log2(std::exp(1.0)) * one));
+    log2e->scaling_factor() = N;
+
+    // y, y + 2^K and y - 2^K, decomposed in one a2b for bits of y
+    // and comparisons with both bounds
+    auto stacked_shape = shape();
+    stacked_shape.insert(stacked_shape.begin(), 3);
+    auto stacked = tensor_factory()->template malloc_tensor<T>(5, stacked_shape);
+    FixedPointTensor y(stacked[0].get(), stacked[1].get());
+    BooleanTensor<T> bits(stacked[2].get(), stacked[3].get());
+    auto y_ = tensor_factory()->template malloc_tensor<T>(2, shape());
+    FixedPointTensor y0(y_[0].get(), y_[1].get());
+    mul(log2e.get(), &y0);
+    for (size_t i = 0; i < 2; ++i) {
+        for (size_t k = 0; k < 3; ++k) {
+            std::copy(y0.share(i)->data(), y0.share(i)->data() + numel,
+                      y.mutable_share(i)->data() + k * numel);
+        }
+    }
+    auto bounds = stacked[4].get();
+    std::fill(bounds->data(), bounds->data() + numel, T(0));
+    std::fill(bounds->data() + numel, bounds->data() + 2 * numel, one << K);
+    std::fill(bounds->data() + 2 * numel, bounds->data() + 3 * numel,
+              -(one << K));
+    bounds->scaling_factor() = N;
+    y.add(bounds, &y);
+    bits = &y;
+
+    // (row of stacked, bit, weight, target), targets are t, K factors,
+    // sign factor (0 if y < -2^K or y >= 2^K) and saturation 2^(2^K)
+    struct Entry {
+        size_t row;
+        size_t bit;
+        T weight;
+        size_t target;
+    };
+    const size_t sign_target = K + 1;
+    const size_t sat_target = K + 2;
+    const size_t msb = sizeof(T) * 8 - 1;
+    const T min_pow = one >> (1 << K);
+    std::vector<Entry> entries;
+    for (size_t j = 0; j < N; ++j) {
+        entries.push_back({ 0, j, T(1) << j, 0 });
+    }
+    for (size_t i = 0; i < K; ++i) {
+        entries.push_back({ 0, N + i, (one << (1 << i)) - one, i + 1 });
+    }
+    // with s = msb(y), u = msb(y + 2^K) and v = msb(y - 2^K), sign factor
+    // is s * 2^-(2^K) + (1 - s) - u * 2^-(2^K) - (1 - v), in which u
+    // implies s and 1 - v implies 1 - s, and saturation is (1 - v) * 2^(2^K)
+    entries.push_back({ 0, msb, min_pow - one, sign_target });
+    entries.push_back({ 1, msb, -min_pow, sign_target });
+    entries.push_back({ 2, msb, one, sign_target });
+    entries.push_back({ 2, msb, -(one << (1 << K)), sat_target });
+
+    auto bits_shape = shape();
+    bits_shape.insert(bits_shape.begin(), entries.size());
+    auto ab = tensor_factory()->template malloc_tensor<T>(5, bits_shape);
+    for (size_t e = 0; e < entries.size(); ++e) {
+        const auto& entry = entries[e];
+        for (size_t i = 0; i < 2; ++i) {
+            const T* in = bits.share(i)->data() + entry.row * numel;
+            std::transform(in, in + numel, ab[i]->data() + e * numel,
+                           [&entry](T v) -> T { return (v >> entry.bit) & 1; });
+        }
+        std::fill(ab[2]->data() + e * numel, ab[2]->data() + (e + 1) * numel,
+                  entry.weight);
+    }
+    BooleanTensor<T> bit(ab[0].get(), ab[1].get());
+    FixedPointTensor prod(ab[3].get(), ab[4].get());
+    bit.mul(ab[2].get(), &prod, 0);
+
+    const size_t num_targets = K + 3;
+    auto targets_ = tensor_factory()->template malloc_tensor<T>(
+        2 * num_targets, shape());
+    std::vector<FixedPointTensor> targets;
+    for (size_t k = 0; k < num_targets; ++k) {
+        targets.emplace_back(targets_[2 * k].get(), targets_[2 * k + 1].get());
+    }
+    for (size_t i = 0; i < 2; ++i) {
+        for (auto& target : targets) {
+            assign_to_tensor(target.mutable_share(i), T(0));
+        }
+        for (size_t e = 0; e < entries.size(); ++e) {
+            T* out = targets[entries[e].target].mutable_share(i)->data();
+            const T* in = prod.share(i)->data() + e * numel;
+            std::transform(out, out + numel, in, out, std::plus<T>());
+        }
+    }
+    // public 1 of factors and 2^(2^K) of saturation
+    auto public_one = tensor_factory()->template create<T>(shape());
+    assign_to_tensor(public_one.get(), one);
+    public_one->scaling_factor() = N;
+    for (size_t k = 1; k <= K; ++k) {
+        targets[k].add(public_one.get(), &targets[k]);
+    }
+    assign_to_tensor(public_one.get(), one << (1 << K));
+    targets[sat_target].add(public_one.get(), &targets[sat_target]);
+
+    // 2^t by a degree 4 fit on [0, 1), rel err < 4e-6
+    const std::vector<double> c = { 1.0000034929, 0.6929729222, 0.2416043573,
+                                    0.0517449978, 0.0136703095 };
+    auto powers_ = tensor_factory()->template malloc_tensor<T>(14, shape());
+    std::vector<FixedPointTensor> powers;
+    for (size_t k = 0; k < 7; ++k) {
+        powers.emplace_back(powers_[2 * k].get(), powers_[2 * k + 1].get());
+    }
+    // powers[0..2] = t^2..t^4, powers[3..6] = c[1..4] as public
+    for (size_t k = 1; k < c.size(); ++k) {
+        assign_public(T(c[k] * one), &powers[k + 2]);
+    }
+
+    // factors reduced in pairs along with t^2, t^3 and t^4,
+    // all muls of a level in one round
+    std::vector<FixedPointTensor*> factors;
+    for (size_t k = 1; k <= K; ++k) {
+        factors.push_back(&targets[k]);
+    }
+    FixedPointTensor* t = &targets[0];
+    for (size_t level = 0; factors.size() > 1 || level < 2; ++level) {
+        std::vector<const FixedPointTensor*> lhs;
+        std::vector<const FixedPointTensor*> rhs;
+        std::vector<FixedPointTensor*> out;
+        std::vector<FixedPointTensor*> next;
+        for (size_t k = 0; k + 1 < factors.size(); k += 2) {
+            lhs.push_back(factors[k]);
+            rhs.push_back(factors[k + 1]);
+            out.push_back(factors[k]);
+            next.push_back(factors[k]);
+        }
+        if (factors.size() % 2) {
+            next.push_back(factors.back());
+        }
+        factors.swap(next);
+        if (level == 0) {
+            lhs.push_back(t);
+            rhs.push_back(t);
+            out.push_back(&powers[0]);
+        } else if (level == 1) {
+            lhs.insert(lhs.end(), { &powers[0], &powers[0] });
+            rhs.insert(rhs.end(), { t, &powers[0] });
+            out.insert(out.end(), { &powers[1], &powers[2] });
+        }
+        mul(lhs, rhs, out);
+    }
+
+    // 2^floor(y) = prod * sign factor, and c[i] * t^i
+    FixedPointTensor* pow_int = factors[0];
+    mul({ pow_int, t, &powers[0], &powers[1], &powers[2] },
+        { &targets[sign_target], &powers[3], &powers[4], &powers[5], &powers[6] },
+        { pow_int, t, &powers[0], &powers[1], &powers[2] });
+    auto c0 = tensor_factory()->template create<T>(shape());
+    assign_to_tensor(c0.get(), T(c[0] * one));
+    c0->scaling_factor() = N;
+    t->add(c0.get(), t);
+    for (size_t k = 0; k < 3; ++k) {
+        t->add(&powers[k], t);
+    }
+
+    pow_int->mul(t, ret);
+    ret->add(&targets[sat_target], ret);
+}
+
 template< typename T, size_t N>
 void FixedPointTensor<T, N>::relu(FixedPointTensor<T, N>* ret) const {
     //utilize polynomial_piecewise
@@ -662,26 +973,44 @@ void FixedPointTensor<T, N>::sigmoid(FixedPointTensor<T, N>* ret) const {
 
 // sigmoid(x) = 1 / (1 + exp(-x))
 template< typename T, size_t N>
-void FixedPointTensor<T, N>::sigmoid_high_precision(FixedPointTensor<T, N>* ret) const {
+void FixedPointTensor<T, N>::sigmoid_by_exp(const FixedPointTensor* exp_neg,
+                                            FixedPointTensor* ret) {
     std::vector<std::shared_ptr<TensorAdapter<T>>> temp;
     for (int i = 0; i < 2; ++i) {
         temp.emplace_back(
             tensor_factory()->template create<T>(ret->shape()));
     }
-    auto tensor_one_share0 = tensor_factory()->template create<T>(shape());
-    auto tensor_one_share1 = tensor_factory()->template create<T>(shape());
-    auto tensor_one = tensor_factory()->template create<T>(shape());
+    auto shape = ret->shape();
+    auto tensor_one_share0 = tensor_factory()->template create<T>(shape);
+    auto tensor_one_share1 = tensor_factory()->template create<T>(shape);
+    auto tensor_one = tensor_factory()->template create<T>(shape);
     assign_to_tensor(tensor_one.get(), (T) (1.0 * pow(2, N)));
     tensor_one->scaling_factor() = N;
     assign_to_tensor(tensor_one_share0.get(), (T) (1.0 * pow(2, N) / 3.0));
     assign_to_tensor(tensor_one_share1.get(), (T) (1.0 * pow(2, N) / 3.0));
-    
+
     FixedPointTensor tensor_one_ft(tensor_one_share0.get(), tensor_one_share1.get());
     FixedPointTensor out(temp[0].get(), temp[1].get());
+    exp_neg->add(tensor_one.get(), &out);
+    tensor_one_ft.goldschmidt_div(&out, ret);
+}
+
+template< typename T, size_t N>
+void FixedPointTensor<T, N>::sigmoid_high_precision(FixedPointTensor<T, N>* ret) const {
+    auto temp = tensor_factory()->template malloc_tensor<T>(2, ret->shape());
+    FixedPointTensor out(temp[0].get(), temp[1].get());
     this->negative(&out);
     out.exp(&out);
-    out.add(tensor_one.get(), &out);
-    tensor_one_ft.long_div(&out, ret);
+    sigmoid_by_exp(&out, ret);
+}
+
+template< typename T, size_t N>
+void FixedPointTensor<T, N>::sigmoid_high_precision_split(FixedPointTensor<T, N>* ret) const {
+    auto temp = tensor_factory()->template malloc_tensor<T>(2, ret->shape());
+    FixedPointTensor out(temp[0].get(), temp[1].get());
+    this->negative(&out);
+    out.exp_split(&out);
+    sigmoid_by_exp(&out, ret);
 }
 
 template< typename T, size_t N>
@@ -735,7 +1064,9 @@ void FixedPointTensor<T, N>::sigmoid_enhanced(FixedPointTensor<T, N>* ret) const
 
 template< typename T, size_t N>
 void FixedPointTensor<T, N>::softmax(FixedPointTensor<T, N>* ret,
-                                     bool use_relu, bool use_long_div) const {
+                                     bool use_relu, bool use_long_div,
+                                     bool use_goldschmidt_div,
+                                     bool use_split_exp) const {
     // softmax axis = -1
     const size_t col = *(shape().end() - 1);
     const size_t row = numel() / col;
@@ -818,21 +1149,30 @@ void FixedPointTensor<T, N>::softmax(FixedPointTensor<T, N>* ret,
 
         x.sub(&max_x_broadcast, &x);
 
-        // n = 64, see exp
-        assign_to_tensor(exp_lower_bound, (T)(-64 * (1 << N)));
-        exp_lower_bound->scaling_factor() = N;
+        if (use_split_exp) {
+            // exp_split is 0 below its range, no clamp needed
+            x.exp_split(&x);
+        } else {
+            // n = 64, see exp
+            assign_to_tensor(exp_lower_bound, (T)(-64 * (1 << N)));
+            exp_lower_bound->scaling_factor() = N;
 
-        x.sub(exp_lower_bound, &x);
-        x.relu(&x);
-        x.add(exp_lower_bound, &x);
+            x.sub(exp_lower_bound, &x);
+            x.relu(&x);
+            x.add(exp_lower_bound, &x);
 
-        x.exp(&x);
+            x.exp(&x);
+        }
     }
 
     // reuse max_x as sum
     reduce(&x, &max_x);
 
-    if (!use_long_div) { // invert sum by Newton's method
+    // sum of exp is in [1, col], within range of goldschmidt_div
+    use_goldschmidt_div = use_goldschmidt_div && !use_relu;
+    use_long_div = use_long_div && !use_goldschmidt_div;
+
+    if (!use_long_div && !use_goldschmidt_div) { // invert sum by Newton's method
     // divisor range = [1/col, 1.0]
     // TODO: find better iter num & init val
         reciprocal(&max_x, &max_x, 16, 0.5 / col);
@@ -841,7 +1181,9 @@ void FixedPointTensor<T, N>::softmax(FixedPointTensor<T, N>* ret,
     broadcast(max_x.share(0), max_x_broadcast.mutable_share(0));
     broadcast(max_x.share(1), max_x_broadcast.mutable_share(1));
 
-    if (use_long_div) {
+    if (use_goldschmidt_div) {
+        x.goldschmidt_div(&max_x_broadcast, &x);
+    } else if (use_long_div) {
         x.long_div(&max_x_broadcast, &x, 1);
     } else {
         x.mul(&max_x_broadcast, &x);
@@ -873,9 +1215,9 @@ void FixedPointTensor<T, N>::long_div(const FixedPointTensor<T, N>* rhs,
     assign_to_tensor(cmp_res_all.share(0), (T)0);
     assign_to_tensor(cmp_res_all.share(1), (T)0);
 
-    const size_t msb = sizeof(T) * 8 - 1;
-    sign_lhs.bit_extract(msb, this);
-    sign_rhs.bit_extract(msb, rhs);
+    // signs of both in one run
+    BooleanTensor<T>::msb(std::vector<const FixedPointTensor*>{ this, rhs },
+                          std::vector<BooleanTensor<T>*>{ &sign_lhs, &sign_rhs });
     sign_lhs.bitwise_xor(&sign_rhs, &sign_ret);
 
     auto lshift = []  (const FixedPointTensor<T, N>* in,
@@ -930,6 +1272,131 @@ void FixedPointTensor<T, N>::long_div(const FixedPointTensor<T, N>* rhs,
     abs(&abs_lhs, &sign_ret, ret);
 }
 
+template<typename T, size_t N>
+void FixedPointTensor<T, N>::lookup_msb(const FixedPointTensor* x,
+                                        const std::vector<std::vector<T>>& weights,
+                                        const std::vector<FixedPointTensor*>& out) {
+    const size_t numel = x->numel();
+    const size_t num = weights.size();
+    const size_t width = weights[0].size();
+    for (auto& w : weights) {
+        PADDLE_ENFORCE_EQ(w.size(), width, "Weights size should be equal.");
+    }
+    PADDLE_ENFORCE_LT(width, sizeof(T) * 8, "Too many weights.");
+    auto temp = tensor_factory()->template malloc_tensor<T>(4, x->shape());
+    BooleanTensor<T> y(temp[0].get(), temp[1].get());
+    BooleanTensor<T> y_shift(temp[2].get(), temp[3].get());
+
+    // prefix or of bits from msb, then one-hot of msb j of x
+    y = x;
+    for (size_t s = 1; s < sizeof(T) * 8; s <<= 1) {
+        y.logical_rshift(s, &y_shift);
+        y.bitwise_or(&y_shift, &y);
+    }
+    y.logical_rshift(1, &y_shift);
+    y.bitwise_xor(&y_shift, &y);
+
+    // bit_j * weights[i][j] for all i and j < width, stacked
+    auto bits_shape = x->shape();
+    bits_shape.insert(bits_shape.begin(), num * width);
+    auto bits = tensor_factory()->template malloc_tensor<T>(5, bits_shape);
+    for (size_t k = 0; k < num; ++k) {
+        for (size_t j = 0; j < width; ++j) {
+            const size_t offset = (k * width + j) * numel;
+            for (size_t i = 0; i < 2; ++i) {
+                std::transform(y.share(i)->data(), y.share(i)->data() + numel,
+                               bits[i]->data() + offset,
+                               [j](T in) -> T { return (in >> j) & 1; });
+            }
+            std::fill(bits[2]->data() + offset,
+                      bits[2]->data() + offset + numel, weights[k][j]);
+        }
+    }
+    BooleanTensor<T> bit(bits[0].get(), bits[1].get());
+    FixedPointTensor prod(bits[3].get(), bits[4].get());
+    bit.mul(bits[2].get(), &prod, 0);
+
+    for (size_t k = 0; k < num; ++k) {
+        for (size_t i = 0; i < 2; ++i) {
+            T* out_ = out[k]->mutable_share(i)->data();
+            std::fill(out_, out_ + numel, T(0));
+            for (size_t j = 0; j < width; ++j) {
+                const T* prod_ = prod.share(i)->data()
+                                 + (k * width + j) * numel;
+                std::transform(out_, out_ + numel, prod_, out_,
+                               std::plus<T>());
+            }
+        }
+    }
+}
+
+template<typename T, size_t N>
+void FixedPointTensor<T, N>::goldschmidt_div(const FixedPointTensor<T, N>* rhs,
+                                             FixedPointTensor<T, N>* ret) const {
+    // a / d = a * c * w / (d * c * w), in which c = 2^(N - 1 - j) for
+    // msb j of abs(d) normalizes d * c into [0.5, 1), w = 2.9142 - 2 * d * c
+    // approximates its reciprocal with rel error e < 0.0858,
+    // and each goldschmidt iteration squares e
+    auto temp = tensor_factory()->template malloc_tensor<T>(12, shape());
+    BooleanTensor<T> sign(temp[0].get(), temp[1].get());
+    FixedPointTensor abs_rhs(temp[2].get(), temp[3].get());
+    FixedPointTensor c(temp[4].get(), temp[5].get());
+    FixedPointTensor q(temp[6].get(), temp[7].get());
+    FixedPointTensor w(temp[8].get(), temp[9].get());
+    FixedPointTensor e(temp[10].get(), temp[11].get());
+
+    // abs = d - 2 * sign * d
+    sign.msb(rhs);
+    rhs->share(0)->lshift(1, abs_rhs.mutable_share(0));
+    rhs->share(1)->lshift(1, abs_rhs.mutable_share(1));
+    sign.mul(&abs_rhs, &abs_rhs);
+    rhs->sub(&abs_rhs, &abs_rhs);
+
+    // c = 0 if abs(d) >= 2^N, so is the result
+    std::vector<T> c_weights(2 * N);
+    for (size_t j = 0; j < 2 * N; ++j) {
+        c_weights[j] = T(1) << (2 * N - 1 - j);
+    }
+    lookup_msb(&abs_rhs, { c_weights }, { &c });
+
+    auto one = tensor_factory()->template create<T>(shape());
+    assign_to_tensor(one.get(), T(1) << N);
+    one->scaling_factor() = N;
+    auto w0 = tensor_factory()->template create<T>(shape());
+    assign_to_tensor(w0.get(), T(2.9142 * (T(1) << N)));
+    w0->scaling_factor() = N;
+
+    // abs_rhs is normalized into [0.5, 1)
+    mul({ &abs_rhs, this }, { &c, &c }, { &abs_rhs, &q });
+
+    // w = 2.9142 - 2 * d, e = 1 - d * w, q = q * w
+    abs_rhs.share(0)->lshift(1, w.mutable_share(0));
+    abs_rhs.share(1)->lshift(1, w.mutable_share(1));
+    w.negative(&w);
+    w.add(w0.get(), &w);
+    mul({ &abs_rhs, &q }, { &w, &w }, { &e, &q });
+    e.negative(&e);
+    e.add(one.get(), &e);
+
+    // q = q * (1 + e), e = e * e
+    // until e^(2^iter) < 2^-N, i.e. 0.0858^(2^iter) < 2^-N
+    const size_t iter = std::ceil(std::log2(N / -std::log2(0.0858)));
+    for (size_t i = 0; i < iter; ++i) {
+        e.add(one.get(), &w);
+        if (i + 1 < iter) {
+            mul({ &q, &e }, { &w, &e }, { &q, &e });
+        } else {
+            q.mul(&w, &q);
+        }
+    }
+
+    // ret = q - 2 * sign * q
+    q.share(0)->lshift(1, w.mutable_share(0));
+    q.share(1)->lshift(1, w.mutable_share(1));
+    sign.mul(&w, &w);
+    q.sub(&w, ret);
+}
+
 // reduce last dim
 template <typename T, size_t N>
 void FixedPointTensor<T, N>::reduce(const FixedPointTensor<T, N>* input,
@@ -961,45 +1428,88 @@ void FixedPointTensor<T, N>::polynomial(const TensorAdapter<T>* coeff,
                                         FixedPointTensor<T, N>* ret) const {
 
     // e.g., x.shape = {2, 3}, coeff.shape = {n, 2, 3} (n: polynomial power)
+    const size_t degree = coeff->shape()[0] - 1;
+    const size_t numel = this->numel();
 
-    //TODO: improve performance: [ABY3]
-    std::vector<std::shared_ptr<TensorAdapter<T>>> temp;
-    for (int i = 0; i < 7; ++i) {
-        temp.emplace_back(
-            tensor_factory()->template create<T>(this->shape()));
-    }
-    std::shared_ptr<FixedPointTensor<T, N>> x_pow_i =
-            std::make_shared<FixedPointTensor<T, N>>(
-                                temp[0].get(), temp[1].get());
-    std::shared_ptr<FixedPointTensor<T, N>> temp_fixed =
-            std::make_shared<FixedPointTensor<T, N>>(
-                                temp[2].get(), temp[3].get());
-    std::shared_ptr<FixedPointTensor<T, N>> result =
-            std::make_shared<FixedPointTensor<T, N>>(
-                                temp[5].get(), temp[6].get());
-    assign_to_tensor(result->_share[0], (T) 0);
-    assign_to_tensor(result->_share[1], (T) 0);
-
-    //x_pow_i.get() = 1;
-    assign_to_tensor(x_pow_i.get()->_share[0], (T) 0);
-    assign_to_tensor(x_pow_i.get()->_share[1], (T) 0);
-    assign_to_tensor(temp[4].get(), (T) 1 << N);
-    temp[4]->scaling_factor() = N;
-    x_pow_i->add(temp[4].get(), x_pow_i.get());
-
-    for (int i = 0; i < coeff->shape()[0]; ++i) {
+    auto coeff_i = [coeff](size_t i) {
         auto t = tensor_factory()->template create<T>();
         coeff->slice(i, i + 1, t.get());
         auto t_shape = t->shape();
         // remove leading 1
         t_shape.erase(t_shape.begin());
         t->reshape(t_shape);
-        x_pow_i->mul(t.get(), temp_fixed.get());
-        result->add(temp_fixed.get(), result.get());
-        x_pow_i->mul(this, x_pow_i.get());
+        return t;
+    };
+
+    // shares of x^i, i >= 1
+    std::vector<std::shared_ptr<TensorAdapter<T>>> powers[2];
+    for (int s = 0; s < 2; ++s) {
+        powers[s].resize(degree + 1);
+        if (degree > 0) {
+            powers[s][1] = tensor_factory()->template create<T>(shape());
+            _share[s]->copy(powers[s][1].get());
+        }
     }
-    result->share(0)->copy(ret->mutable_share(0));
-    result->share(1)->copy(ret->mutable_share(1));
+
+    // x^(h + j) = x^h * x^j for j in [1, h], muls of a level are stacked
+    // into one mul, so powers up to degree take ceil(log2(degree)) rounds
+    for (size_t h = 1; h < degree; h *= 2) {
+        const size_t m = std::min(h, degree - h);
+        auto stacked_shape = shape();
+        stacked_shape.insert(stacked_shape.begin(), m);
+        // lhs, rhs and result, two shares each
+        auto buf = tensor_factory()->template malloc_tensor<T>(6, stacked_shape);
+        for (size_t j = 0; j < m; ++j) {
+            for (int s = 0; s < 2; ++s) {
+                std::copy(powers[s][h]->data(), powers[s][h]->data() + numel,
+                          buf[s]->data() + j * numel);
+                std::copy(powers[s][j + 1]->data(),
+                          powers[s][j + 1]->data() + numel,
+                          buf[2 + s]->data() + j * numel);
+            }
+        }
+        FixedPointTensor lhs(buf[0].get(), buf[1].get());
+        FixedPointTensor rhs(buf[2].get(), buf[3].get());
+        FixedPointTensor out(buf[4].get(), buf[5].get());
+        lhs.mul(&rhs, &out);
+
+        for (size_t j = 0; j < m; ++j) {
+            for (int s = 0; s < 2; ++s) {
+                auto& power = powers[s][h + j + 1];
+                power = tensor_factory()->template create<T>(shape());
+                std::copy(buf[4 + s]->data() + j * numel,
+                          buf[4 + s]->data() + (j + 1) * numel,
+                          power->data());
+            }
+        }
+    }
+
+    // sum of coeff[i] * x^i, i >= 0, with scaling factor of coeff + N,
+    // truncated once
+    auto temp = tensor_factory()->template malloc_tensor<T>(3, shape());
+    FixedPointTensor result(temp[0].get(), temp[1].get());
+    assign_to_tensor(result._share[0], (T) 0);
+    assign_to_tensor(result._share[1], (T) 0);
+
+    // coeff[0] * x^0, public and held as x_0 by party 0 and 2
+    auto c = coeff_i(0);
+    if (party() == 0) {
+        c->lshift(N, temp[2].get());
+        result._share[0]->add(temp[2].get(), result._share[0]);
+    } else if (party() == 2) {
+        c->lshift(N, temp[2].get());
+        result._share[1]->add(temp[2].get(), result._share[1]);
+    }
+
+    for (size_t i = 1; i <= degree; ++i) {
+        c = coeff_i(i);
+        for (int s = 0; s < 2; ++s) {
+            powers[s][i]->mul(c.get(), temp[2].get());
+            result._share[s]->add(temp[2].get(), result._share[s]);
+        }
+    }
+
+    truncate(&result, ret, coeff->scaling_factor());
 }
 
 template< typename T, size_t N>
@@ -1011,103 +1521,96 @@ void FixedPointTensor<T, N>::polynomial_piecewise(
     // e.g., x.shape = {2, 3},
     // break_point.shape = {k, 2, 3} (k: num of break point)
     //       coeff.shape = {k + 1, n, 2, 3} (n: poly power)
-
-    // copy ret
-    auto ret_cpy_s0 = tensor_factory()->create_int64_t(ret->share(0)->shape());
-    ret->share(0)->copy(ret_cpy_s0.get());
-    auto ret_cpy_s1 = tensor_factory()->create_int64_t(ret->share(1)->shape());
-    ret->share(1)->copy(ret_cpy_s1.get());
-    std::shared_ptr<FixedPointTensor<T, N>> ret_cpy{new FixedPointTensor<T, N>(ret_cpy_s0.get(), ret_cpy_s1.get())};
-
-    std::vector<std::shared_ptr<BooleanTensor<T>>> msb;
-
-    int len_break_point = break_point->shape()[0];
-    int len_coeff = coeff->shape()[0];
-
-    //number of temp tensor used
-    int temp_total = 4 * len_break_point + 2 +
-                     2 * (len_break_point - 1) + 2 + 4 * len_coeff;
-    std::vector<std::shared_ptr<TensorAdapter<T>>> temp;
-    for (int i = 0; i < temp_total; ++i) {
-        temp.emplace_back(tensor_factory()->
-                          template create<T>(this->shape()));
+    // break points of each element should be in ascending order
+
+    const size_t k = break_point->shape()[0];
+    const size_t len_coeff = coeff->shape()[1];
+    const size_t numel = this->numel();
+
+    // selectors below rely on the order, break points are public
+    PADDLE_ENFORCE_EQ(break_point->numel(), k * numel,
+                      "Break point numel should be k * numel of input.");
+    const T* bp = break_point->data();
+    bool ascending = true;
+    for (size_t j = numel; j < k * numel; ++j) {
+        ascending &= bp[j - numel] <= bp[j];
     }
-    int temp_index = 0;
-
-    // std::vector<std::shared_ptr<TensorAdapter<T>>> paddle_t_break;
-    std::vector<std::shared_ptr<FixedPointTensor<T, N>>> temp1;
+    PADDLE_ENFORCE(ascending, "Break points should be in ascending order.");
 
-    for (int i = 0; i < break_point->shape()[0]; ++i) {
-        // msb[i] = msb(x - break_point[i])
-        auto t_break = tensor_factory()->template create<T>();
-        break_point->slice(i, i + 1, t_break.get());
+    auto stacked = [this](size_t num) {
+        auto s = shape();
+        s.insert(s.begin(), num);
+        return s;
+    };
 
-        auto t_shape = t_break->shape();
-        // remove leading 1
-        t_shape.erase(t_shape.begin());
-        t_break->reshape(t_shape);
-
-        temp1.emplace_back(
-                    std::make_shared<FixedPointTensor<T, N>>(
-                                    temp[temp_index++].get(),
-                                    temp[temp_index++].get()));
-        this->sub(t_break.get(), temp1[i].get());
-        msb.emplace_back(std::make_shared<BooleanTensor<T>>(
-                                    temp[temp_index++].get(),
-                                    temp[temp_index++].get()));
-        msb[i]->bit_extract(sizeof(T) * 8 - 1, temp1[i].get());
-    }
-
-    // b[0] = msb[0], b[i + 1] = ~ msb[i] & msb[i + 1]
-    std::vector<std::shared_ptr<BooleanTensor<T>>> b;
-    b.emplace_back(std::make_shared<BooleanTensor<T>>(
-                                    temp[temp_index++].get(),
-                                    temp[temp_index++].get()));
-    b[0] = msb[0];
-
-    for (int i = 0; i < len_break_point - 1; ++i) {
-        b.emplace_back(std::make_shared<BooleanTensor<T>>(
-                                    temp[temp_index++].get(),
-                                    temp[temp_index++].get()));
-
-        msb[i]->bitwise_not(b[i + 1].get());
-        b[i + 1]->bitwise_and(msb[i + 1].get(), b[i + 1].get());
-    }
-
-    b.emplace_back(std::make_shared<BooleanTensor<T>>(
-                                    temp[temp_index++].get(),
-                                    temp[temp_index++].get()));
-    msb[len_break_point - 1]->bitwise_not(b[len_break_point].get());
-
-    // ret += b[i].mul(polynomial(coeff[i]))
-    std::vector<std::shared_ptr<FixedPointTensor<T, N>>> temp_fixed;
-    std::vector<std::shared_ptr<FixedPointTensor<T, N>>> temp_fixed1;
-
-    assign_to_tensor(ret_cpy->_share[0], (T) 0);
-    assign_to_tensor(ret_cpy->_share[1], (T) 0);
-
-    for (int i = 0; i < len_coeff; ++i) {
-        temp_fixed.emplace_back(
-                    std::make_shared<FixedPointTensor<T, N>>(
-                                                temp[temp_index++].get(),
-                                                temp[temp_index++].get()));
-        temp_fixed1.emplace_back(
-                    std::make_shared<FixedPointTensor<T, N>>(
-                                                temp[temp_index++].get(),
-                                                temp[temp_index++].get()));
-        auto t = tensor_factory()->template create<T>();
-        coeff->slice(i, i + 1, t.get());
-        auto t_shape = t->shape();
-        // remove leading 1
-        t_shape.erase(t_shape.begin());
-        t->reshape(t_shape);;
-        this->polynomial(t.get(), temp_fixed[i].get());
-        b[i]->bit_extract(0, b[i].get());
-        b[i]->mul(temp_fixed[i].get(), temp_fixed1[i].get());
-        ret_cpy->add(temp_fixed1[i].get(), ret_cpy.get());
+    // x - break_point[i] of all break points stacked, to run msb circuit once
+    auto temp = tensor_factory()->template malloc_tensor<T>(4, stacked(k));
+    for (size_t i = 0; i < k; ++i) {
+        for (int s = 0; s < 2; ++s) {
+            std::copy(_share[s]->data(), _share[s]->data() + numel,
+                      temp[s]->data() + i * numel);
+        }
+    }
+    FixedPointTensor x_k(temp[0].get(), temp[1].get());
+    x_k.sub(break_point, &x_k);
+    BooleanTensor<T> msb(temp[2].get(), temp[3].get());
+    msb.bit_extract(sizeof(T) * 8 - 1, &x_k);
+
+    // with ascending break points, msb[i] implies msb[i + 1], so that
+    // b[0] = msb[0], b[i] = ~msb[i - 1] & msb[i] = msb[i - 1] ^ msb[i],
+    // b[k] = ~msb[k - 1], all local
+    auto b_s = tensor_factory()->template malloc_tensor<T>(2, stacked(k + 1));
+    for (int s = 0; s < 2; ++s) {
+        const T* m = temp[2 + s]->data();
+        T* b = b_s[s]->data();
+        std::copy(m, m + numel, b);
+        for (size_t j = 0; j < (k - 1) * numel; ++j) {
+            b[numel + j] = m[j] ^ m[numel + j];
+        }
+        std::copy(m + (k - 1) * numel, m + k * numel, b + k * numel);
+    }
+    // public 1 held as x_0, as bitwise_not
+    if (party() != 1) {
+        T* b = b_s[party() == 0 ? 0 : 1]->data() + k * numel;
+        std::for_each(b, b + numel, [](T& val) { val ^= 1; });
+    }
+    BooleanTensor<T> b(b_s[0].get(), b_s[1].get());
+
+    // polynomials of all pieces stacked,
+    // coeff {k + 1, n, ...} transposed to {n, k + 1, ...}
+    auto x_s = tensor_factory()->template malloc_tensor<T>(4, stacked(k + 1));
+    for (size_t i = 0; i < k + 1; ++i) {
+        for (int s = 0; s < 2; ++s) {
+            std::copy(_share[s]->data(), _share[s]->data() + numel,
+                      x_s[s]->data() + i * numel);
+        }
+    }
+    auto c_shape = stacked(k + 1);
+    c_shape.insert(c_shape.begin(), len_coeff);
+    auto c = tensor_factory()->template create<T>(c_shape);
+    for (size_t i = 0; i < k + 1; ++i) {
+        for (size_t j = 0; j < len_coeff; ++j) {
+            const T* src = coeff->data() + (i * len_coeff + j) * numel;
+            std::copy(src, src + numel,
+                      c->data() + (j * (k + 1) + i) * numel);
+        }
+    }
+    c->scaling_factor() = coeff->scaling_factor();
+
+    FixedPointTensor x(x_s[0].get(), x_s[1].get());
+    FixedPointTensor poly(x_s[2].get(), x_s[3].get());
+    x.polynomial(c.get(), &poly);
+
+    // ret = sum(b[i] * poly[i])
+    b.mul(&poly, &x);
+    for (int s = 0; s < 2; ++s) {
+        T* r = ret->_share[s]->data();
+        const T* p = x_s[s]->data();
+        std::copy(p, p + numel, r);
+        for (size_t i = 1; i < k + 1; ++i) {
+            std::transform(r, r + numel, p + i * numel, r, std::plus<T>());
+        }
     }
-    ret_cpy->share(0)->copy(ret->mutable_share(0));
-    ret_cpy->share(1)->copy(ret->mutable_share(1));
 }
 
 template<typename T, size_t N>
@@ -1175,6 +1678,29 @@ void FixedPointTensor<T, N>::geq(const CTensor<T, N1...>* rhs,
     ret->bitwise_xor(tensor_one.get(), ret);
 }
 
+template<typename T, size_t N>
+void FixedPointTensor<T, N>::lt(const std::vector<const FixedPointTensor*>& lhs,
+                                const std::vector<const FixedPointTensor*>& rhs,
+                                const std::vector<BooleanTensor<T>*>& ret) {
+    PADDLE_ENFORCE_EQ(lhs.size(), rhs.size(),
+                      "Input and output size not match.");
+    std::vector<std::shared_ptr<TensorAdapter<T>>> temp;
+    std::vector<FixedPointTensor> sub_result;
+    std::vector<const FixedPointTensor*> sub_result_;
+    for (size_t i = 0; i < lhs.size(); ++i) {
+        for (int j = 0; j < 2; ++j) {
+            temp.emplace_back(
+                tensor_factory()->template create<T>(lhs[i]->shape()));
+        }
+        sub_result.emplace_back(temp[2 * i].get(), temp[2 * i + 1].get());
+        lhs[i]->sub(rhs[i], &sub_result.back());
+    }
+    for (auto& t : sub_result) {
+        sub_result_.emplace_back(&t);
+    }
+    BooleanTensor<T>::msb(sub_result_, ret);
+}
+
 template<typename T, size_t N>
 template<template<typename U, size_t...> class CTensor,
             size_t... N1>
@@ -1206,7 +1732,7 @@ void FixedPointTensor<T, N>::neq(const CTensor<T, N1...>* rhs,
 
     this->lt(rhs, lt.get());
     this->gt(rhs, gt.get());
-    lt->bitwise_or(gt.get(), ret);
+    lt->bit_or(gt.get(), ret);
 }
 
 template<typename T, size_t N>
@@ -1294,6 +1820,66 @@ void FixedPointTensor<T, N>::inverse_square_root(const FixedPointTensor* op,
     y->share(1)->copy(ret->mutable_share(1));
 }
 
+template<typename T, size_t N>
+void FixedPointTensor<T, N>::inverse_square_root_normalized(
+    FixedPointTensor* ret) const {
+    // 1 / sqrt(x) = s / sqrt(x * c), in which c = 2^(2k), s = 2^k
+    // for k = floor((N - 1 - j) / 2) and msb j of x, so x * c is in
+    // [0.25, 1). work with g = 1 / (2 * sqrt(x * c)) to save halvings.
+    // c is held with 2N fractional bits for k down to -N, i.e. j < 3N,
+    // larger x has a result below 2^-N, given as 0
+    auto temp = tensor_factory()->template malloc_tensor<T>(14, shape());
+    FixedPointTensor x(temp[0].get(), temp[1].get());
+    FixedPointTensor c(temp[2].get(), temp[3].get());
+    FixedPointTensor s(temp[4].get(), temp[5].get());
+    FixedPointTensor g(temp[6].get(), temp[7].get());
+    FixedPointTensor g2(temp[8].get(), temp[9].get());
+    FixedPointTensor xg(temp[10].get(), temp[11].get());
+    FixedPointTensor three_halves(temp[12].get(), temp[13].get());
+
+    std::vector<T> c_weights(3 * N);
+    std::vector<T> s_weights(3 * N);
+    for (size_t j = 0; j < 3 * N; ++j) {
+        const int d = int(N) - 1 - int(j);
+        const int k = d >= 0 ? d / 2 : -((1 - d) / 2);
+        c_weights[j] = T(1) << (2 * k + 2 * N);
+        s_weights[j] = T(1) << (k + N);
+    }
+    lookup_msb(this, { c_weights, s_weights }, { &c, &s });
+    mul(&c, &x, 2 * N);
+
+    // initial g from a degree 2 fit of 1 / (2 * sqrt(x)) on [0.25, 1),
+    // rel err < 0.024
+    const std::vector<double> w = { 1.3354176944, -1.6426783096, 0.8192839337 };
+    auto coeff_shape = shape();
+    coeff_shape.insert(coeff_shape.begin(), w.size());
+    auto coeff = tensor_factory()->template create<T>(coeff_shape);
+    const size_t numel = this->numel();
+    for (size_t i = 0; i < w.size(); ++i) {
+        std::fill(coeff->data() + i * numel, coeff->data() + (i + 1) * numel,
+                  T(w[i] * (T(1) << N)));
+    }
+    coeff->scaling_factor() = N;
+    x.polynomial(coeff.get(), &g);
+
+    assign_public(T(1.5 * (T(1) << N)), &three_halves);
+
+    // newton step g = 1.5 * g - 2 * x * g^3 squares rel err e into 1.5 * e^2,
+    // two rounds each
+    for (double e = 0.024; e >= 1.0 / (T(1) << N); e = 1.5 * e * e) {
+        mul({ &g, &x }, { &g, &g }, { &g2, &xg });
+        mul({ &xg, &g }, { &g2, &three_halves }, { &xg, &g });
+        xg.share(0)->lshift(1, xg.mutable_share(0));
+        xg.share(1)->lshift(1, xg.mutable_share(1));
+        g.sub(&xg, &g);
+    }
+
+    // ret = 2 * g * s, 0 if x is out of range
+    g.mul(&s, ret);
+    ret->share(0)->lshift(1, ret->mutable_share(0));
+    ret->share(1)->lshift(1, ret->mutable_share(1));
+}
+
 template<typename T, size_t N>
 template<template<typename U, size_t...> class CTensor,
             size_t... N1>
@@ -1326,56 +1912,113 @@ void FixedPointTensor<T, N>::max(const CTensor<T, N1...>* rhs,
 template<typename T, size_t N>
 void FixedPointTensor<T, N>::max_pooling(FixedPointTensor* ret,
                                          BooleanTensor<T>* pos) const {
-    size_t k = shape()[0];
-    std::vector<std::shared_ptr<TensorAdapter<T>>> tmp;
-    for (int i = 0; i < 4; ++i) {
-        tmp.emplace_back(
-            tensor_factory()->template create<T>());
+    // tournament of pairs, all pairs of a level are compared in one
+    // batched max, so it takes ceil(log2(k)) levels instead of k - 1
+    auto shape_ = shape();
+    const size_t k = shape_[0];
+    const size_t n = numel() / k;
+
+    // candidates of current level, candidate j is the largest
+    // of slices [bounds[j], bounds[j + 1])
+    auto cand = tensor_factory()->template malloc_tensor<T>(2, shape_);
+    share(0)->copy(cand[0].get());
+    share(1)->copy(cand[1].get());
+    std::vector<size_t> bounds(k + 1);
+    for (size_t i = 0; i <= k; ++i) {
+        bounds[i] = i;
     }
 
-    FixedPointTensor now(tmp[0].get(), tmp[1].get());
-    BooleanTensor<T> cmp(tmp[2].get(), tmp[3].get());
-    auto cmp_ptr = pos ? &cmp : nullptr;
-
-    share(0)->slice(0, 1, tmp[0].get());
-    share(1)->slice(0, 1, tmp[1].get());
-
-    tmp[0]->copy(ret->mutable_share(0));
-    tmp[1]->copy(ret->mutable_share(1));
+    // xor public bit b into boolean shares, held as x_0
+    auto xor_public_bit = [this, n](T b, const T* in0, const T* in1,
+                                     T* out0, T* out1) {
+        std::copy(in0, in0 + n, out0);
+        std::copy(in1, in1 + n, out1);
+        if (party() == 0) {
+            std::for_each(out0, out0 + n, [b](T& v) { v ^= b; });
+        } else if (party() == 2) {
+            std::for_each(out1, out1 + n, [b](T& v) { v ^= b; });
+        }
+    };
 
+    std::vector<std::shared_ptr<TensorAdapter<T>>> sel;
+    std::vector<T> zeros;
     if (pos) {
-        pos->share(0)->slice(0, 1, tmp[2].get());
-        pos->share(1)->slice(0, 1, tmp[3].get());
-
-        // set init 1, slice_0 is larger than null
-        if (party() == 0 || party() == 2) {
-            size_t idx = 2 + (party() == 2);
-            assign_to_tensor(tmp[idx].get(), T(1));
-            assign_to_tensor(tmp[5 - idx].get(), T(0));
-        } else {
-            assign_to_tensor(tmp[2].get(), T(0));
-            assign_to_tensor(tmp[3].get(), T(0));
+        // set init 1, every slice may be the largest
+        zeros.resize(n, T(0));
+        for (size_t s = 0; s < k; ++s) {
+            xor_public_bit(T(1), zeros.data(), zeros.data(),
+                           pos->share(0)->data() + s * n,
+                           pos->share(1)->data() + s * n);
         }
-
+        sel = tensor_factory()->template malloc_tensor<T>(2, shape_);
     }
 
-    for (size_t i = 1; i < k; ++i) {
-        share(0)->slice(i, i + 1, tmp[0].get());
-        share(1)->slice(i, i + 1, tmp[1].get());
+    for (size_t m = k; m > 1; m = (m + 1) / 2) {
+        const size_t h = m / 2;
+        auto level_shape = shape_;
+        level_shape[0] = h;
+        // lhs, rhs, out and cmp
+        auto tmp = tensor_factory()->template malloc_tensor<T>(8, level_shape);
+        for (size_t i = 0; i < 2; ++i) {
+            for (size_t j = 0; j < h; ++j) {
+                const T* src = cand[i]->data() + 2 * j * n;
+                std::copy(src, src + n, tmp[i]->data() + j * n);
+                std::copy(src + n, src + 2 * n, tmp[2 + i]->data() + j * n);
+            }
+        }
+        FixedPointTensor lhs(tmp[0].get(), tmp[1].get());
+        FixedPointTensor rhs(tmp[2].get(), tmp[3].get());
+        FixedPointTensor out(tmp[4].get(), tmp[5].get());
+        BooleanTensor<T> cmp(tmp[6].get(), tmp[7].get());
+
+        // cmp = 1 if rhs is larger, ties go to lhs
+        // i.e. the first of largest elements wins
+        lhs.max(&rhs, &out, pos ? &cmp : nullptr);
 
         if (pos) {
-            pos->share(0)->slice(i, i + 1, tmp[2].get());
-            pos->share(1)->slice(i, i + 1, tmp[3].get());
+            // slices of lhs stay alive with ~cmp, slices of rhs with cmp,
+            // slices of the odd candidate out with 1
+            for (size_t j = 0; j < h; ++j) {
+                const T* c0 = cmp.share(0)->data() + j * n;
+                const T* c1 = cmp.share(1)->data() + j * n;
+                for (size_t s = bounds[2 * j]; s < bounds[2 * j + 2]; ++s) {
+                    T flip = s < bounds[2 * j + 1] ? T(1) : T(0);
+                    xor_public_bit(flip, c0, c1, sel[0]->data() + s * n,
+                                   sel[1]->data() + s * n);
+                }
+            }
+            for (size_t s = bounds[2 * h]; s < bounds[m]; ++s) {
+                xor_public_bit(T(1), zeros.data(), zeros.data(),
+                               sel[0]->data() + s * n, sel[1]->data() + s * n);
+            }
+            BooleanTensor<T> sel_(sel[0].get(), sel[1].get());
+            pos->bit_and(&sel_, pos);
         }
 
-        ret->max(&now, ret, cmp_ptr);
-
-    }
+        auto next_shape = shape_;
+        next_shape[0] = m - h;
+        auto next = tensor_factory()->template malloc_tensor<T>(2, next_shape);
+        for (size_t i = 0; i < 2; ++i) {
+            std::copy(tmp[4 + i]->data(), tmp[4 + i]->data() + h * n,
+                      next[i]->data());
+            if (m % 2) {
+                std::copy(cand[i]->data() + (m - 1) * n,
+                          cand[i]->data() + m * n,
+                          next[i]->data() + h * n);
+            }
+        }
+        cand = next;
 
-    if (pos) {
-        pos->onehot_from_cmp();
+        for (size_t j = 0; j < h; ++j) {
+            bounds[j + 1] = bounds[2 * j + 2];
+        }
+        if (m % 2) {
+            bounds[h + 1] = bounds[m];
+        }
     }
 
+    cand[0]->copy(ret->mutable_share(0));
+    cand[1]->copy(ret->mutable_share(1));
 }
 
 template<typename T, size_t N>
@@ -1495,47 +2138,33 @@ void FixedPointTensor<T, N>::calc_precision_recall(
         temp.emplace_back(
             tensor_factory()->template create<T>());
     }
-    std::vector<size_t> shape_ = {3};
 
-    std::vector<size_t> shape_one = {1};
+    // precision and recall are computed side by side in one tensor
+    // [tp, tp] / [tp + fp, tp + fn], so that division and reveal are
+    // done once for both
+    std::vector<size_t> shape_two = {2};
 
-    temp[0]->reshape(shape_one);
-    temp[1]->reshape(shape_one);
-    FixedPointTensor scalar(temp[0].get(), temp[1].get());
-
-    temp[2]->reshape(shape_one);
-    temp[3]->reshape(shape_one);
-    FixedPointTensor scalar2(temp[2].get(), temp[3].get());
-
-    auto get = [&tp_fp_fn](size_t idx, FixedPointTensor* dest) {
-        dest->mutable_share(0)->data()[0] = tp_fp_fn->share(0)->data()[idx];
-        dest->mutable_share(1)->data()[0] = tp_fp_fn->share(1)->data()[idx];
-    };
-
-    get(0, &scalar);
-    get(1, &scalar2);
-
-    // tp + fp
-    scalar.add(&scalar2, &scalar2);
-
-    scalar.long_div(&scalar2, &scalar2);
+    for (auto& t : temp) {
+        t->reshape(shape_two);
+    }
+    FixedPointTensor tp(temp[0].get(), temp[1].get());
+    FixedPointTensor denominator(temp[2].get(), temp[3].get());
+
+    for (size_t i = 0; i < 2; ++i) {
+        auto s = tp_fp_fn->share(i)->data();
+        tp.mutable_share(i)->data()[0] = s[0];
+        tp.mutable_share(i)->data()[1] = s[0];
+        denominator.mutable_share(i)->data()[0] = s[0] + s[1];
+        denominator.mutable_share(i)->data()[1] = s[0] + s[2];
+    }
 
-    temp[4]->reshape(shape_one);
+    tp.long_div(&denominator, &denominator);
 
-    scalar2.reveal(temp[4].get());
+    denominator.reveal(temp[4].get());
 
     ret->scaling_factor() = N;
     ret->data()[0] = temp[4]->data()[0];
-
-    get(2, &scalar2);
-
-    // tp + fn
-    scalar.add(&scalar2, &scalar2);
-
-    scalar.long_div(&scalar2, &scalar2);
-    scalar2.reveal(temp[4].get());
-
-    ret->data()[1] = temp[4]->data()[0];
+    ret->data()[1] = temp[4]->data()[1];
 
     float precision = 1.0 * ret->data()[0] / (T(1) << N);
     float recall = 1.0 * ret->data()[1] / (T(1) << N);
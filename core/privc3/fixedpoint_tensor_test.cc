@@ -12,6 +12,8 @@ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 See the License for the specific language governing permissions and
 limitations under the License. */
 
+#include <fstream>
+#include <random>
 #include <string>
 #include <cmath>
 
@@ -21,7 +23,7 @@ limitations under the License. */
 #include "paddle/fluid/framework/scope.h"
 
 #include "aby3_context.h"
-#include "core/paddlefl_mpc/mpc_protocol/network/mesh_network.h"
+#include "core/paddlefl_mpc/mpc_protocol/network/mesh_network_shm.h"
 #include "core/paddlefl_mpc/mpc_protocol/context_holder.h"
 #include "fixedpoint_tensor.h"
 
@@ -37,7 +39,6 @@ public:
     paddle::platform::CPUDeviceContext _cpu_ctx;
     std::shared_ptr<paddle::framework::ExecutionContext> _exec_ctx;
     std::shared_ptr<AbstractContext> _mpc_ctx[3];
-    std::shared_ptr<gloo::rendezvous::HashStore> _store;
     std::thread _t[3];
     std::shared_ptr<TensorAdapterFactory> _s_tensor_factory;
 
@@ -52,8 +53,6 @@ public:
         _exec_ctx = std::make_shared<paddle::framework::ExecutionContext>(
             *op, scope, _cpu_ctx, ctx);
 
-        _store = std::make_shared<gloo::rendezvous::HashStore>();
-
         std::thread t[3];
         for (size_t i = 0; i < 3; ++i) {
             _t[i] = std::thread(&FixedTensorTest::gen_mpc_ctx, this, i);
@@ -63,12 +62,8 @@ public:
         }
         _s_tensor_factory = std::make_shared<PaddleTensorFactory>(&_cpu_ctx);
     }
-    std::shared_ptr<paddle::mpc::MeshNetwork> gen_network(size_t idx) {
-        return std::make_shared<paddle::mpc::MeshNetwork>(idx,
-                                                          "127.0.0.1",
-                                                          3,
-                                                          "test_prefix",
-                                                          _store);
+    std::shared_ptr<paddle::mpc::MeshNetworkShm> gen_network(size_t idx) {
+        return std::make_shared<paddle::mpc::MeshNetworkShm>(idx, 3, "test_prefix");
     }
     void gen_mpc_ctx(size_t idx) {
         auto net = gen_network(idx);
@@ -261,6 +256,16 @@ void test_fixedt_share(size_t p, TensorAdapter<int64_t>* in,
     }
 }
 
+void test_fixedt_online_share(size_t p, size_t owner,
+               TensorAdapter<int64_t>* in,
+               TensorAdapter<int64_t>* out) {
+    auto s0 = gen(out->shape());
+    auto s1 = gen(out->shape());
+    Fix64N16 result(s0.get(), s1.get());
+    Fix64N16::online_share(owner, in, &result);
+    result.reveal(out);
+}
+
 void test_fixedt_add_fixed(size_t p,
                std::vector<std::shared_ptr<TensorAdapter<int64_t>>> in,
                TensorAdapter<int64_t>* out) {
@@ -277,6 +282,21 @@ void test_fixedt_add_fixed(size_t p,
     result->reveal(out);
 }
 
+void test_fixedt_reveal_many(size_t p,
+               std::vector<std::shared_ptr<TensorAdapter<int64_t>>> in,
+               TensorAdapter<int64_t>* out0,
+               TensorAdapter<int64_t>* out1) {
+    std::vector<std::shared_ptr<TensorAdapter<int64_t>>> temp;
+    for (int i = 0; i < 4; i++) {
+        temp.emplace_back(gen(out0->shape()));
+    }
+
+    test_fixedt_gen_shares(p, in, temp);
+    Fix64N16 lhs(temp[0].get(), temp[1].get());
+    Fix64N16 rhs(temp[2].get(), temp[3].get());
+    Fix64N16::reveal_many({&lhs, &rhs}, {out0, out1});
+}
+
 void test_fixedt_add_plain(size_t p,
                std::vector<std::shared_ptr<TensorAdapter<int64_t>>> in,
                TensorAdapter<int64_t>* out) {
@@ -357,6 +377,65 @@ void test_fixedt_mul_fixed(size_t p,
     result->reveal(out);
 }
 
+void test_fixedt_mul_fixed_preprocessed(size_t p,
+               std::vector<std::shared_ptr<TensorAdapter<int64_t>>> in,
+               TensorAdapter<int64_t>* out,
+               size_t* pairs_left) {
+    std::vector<std::shared_ptr<TensorAdapter<int64_t>>> temp;
+    for (int i = 0; i < 6; i++) {
+        temp.emplace_back(gen(out->shape()));
+    }
+
+    test_fixedt_gen_shares(p, in, temp);
+    Fix64N16::preprocess_trunc_pairs(out->numel() + 1);
+    Fix64N16 lhs(temp[0].get(), temp[1].get());
+    Fix64N16 rhs(temp[2].get(), temp[3].get());
+    Fix64N16 result(temp[4].get(), temp[5].get());
+    lhs.mul(&rhs, &result);
+    result.reveal(out);
+
+    auto ctx = std::dynamic_pointer_cast<ABY3Context>(g_ctx_holder::mpc_ctx());
+    *pairs_left = ctx->store().trunc_pair_size(16);
+}
+
+// run mul once to get its demand, preprocess it, save and load it back,
+// then run mul twice on preprocessed randomness
+void test_fixedt_mul_fixed_preprocess(size_t p,
+               std::vector<std::shared_ptr<TensorAdapter<int64_t>>> in,
+               TensorAdapter<int64_t>* out[3],
+               size_t* left) {
+    std::vector<std::shared_ptr<TensorAdapter<int64_t>>> temp;
+    for (int i = 0; i < 6; i++) {
+        temp.emplace_back(gen(out[0]->shape()));
+    }
+
+    test_fixedt_gen_shares(p, in, temp);
+    Fix64N16 lhs(temp[0].get(), temp[1].get());
+    Fix64N16 rhs(temp[2].get(), temp[3].get());
+    Fix64N16 result(temp[4].get(), temp[5].get());
+
+    auto ctx = std::dynamic_pointer_cast<ABY3Context>(g_ctx_holder::mpc_ctx());
+    auto& store = ctx->store();
+    store.reset_demand();
+    lhs.mul(&rhs, &result);
+    result.reveal(out[0]);
+
+    auto demand = store.demand();
+    Fix64N16::preprocess(demand);
+    std::string path = "./test_preprocessing." + std::to_string(p);
+    store.save(path);
+    store.load(path);
+
+    for (int i = 1; i < 3; ++i) {
+        lhs.mul(&rhs, &result);
+        result.reveal(out[i]);
+    }
+
+    left[0] = demand.trunc_pairs[16];
+    left[1] = store.trunc_pair_size(16);
+    left[2] = std::ifstream(path).good();
+}
+
 void test_fixedt_mul_plain(size_t p,
                std::vector<std::shared_ptr<TensorAdapter<int64_t>>> in,
                TensorAdapter<int64_t>* out) {
@@ -405,6 +484,22 @@ void test_fixedt_div_fixed(size_t p,
     result->reveal(out);
 }
 
+void test_fixedt_goldschmidt_div_fixed(size_t p,
+               std::vector<std::shared_ptr<TensorAdapter<int64_t>>> in,
+               TensorAdapter<int64_t>* out) {
+    std::vector<std::shared_ptr<TensorAdapter<int64_t>>> temp;
+    for (int i = 0; i < 6; i++) {
+        temp.emplace_back(gen(out->shape()));
+    }
+
+    test_fixedt_gen_shares(p, in, temp);
+    Fix64N16* lhs = new Fix64N16(temp[0].get(), temp[1].get());
+    Fix64N16* rhs = new Fix64N16(temp[2].get(), temp[3].get());
+    Fix64N16* result = new Fix64N16(temp[4].get(), temp[5].get());
+    lhs->goldschmidt_div(rhs, result);
+    result->reveal(out);
+}
+
 void test_fixedt_sum_fixed(size_t p,
                std::vector<std::shared_ptr<TensorAdapter<int64_t>>> in,
                TensorAdapter<int64_t>* out) {
@@ -459,6 +554,86 @@ void test_fixedt_poly_fixed(size_t p,
     result->reveal(out);
 }
 
+// polynomial of coefficients w
+void test_fixedt_poly_fixed_coeff(size_t p,
+               std::vector<std::shared_ptr<TensorAdapter<int64_t>>> in,
+               const std::vector<double>& w,
+               TensorAdapter<int64_t>* out) {
+    std::vector<std::shared_ptr<TensorAdapter<int64_t>>> temp;
+    for (int i = 0; i < 4; i++) {
+        temp.emplace_back(gen(out->shape()));
+    }
+
+    test_fixedt_gen_shares(p, in[0], temp);
+
+    auto c_shape = out->shape();
+    c_shape.insert(c_shape.begin(), w.size());
+    auto coeff = gen(c_shape);
+    auto c_ptr = coeff->data();
+    for (size_t i = 0; i < w.size(); i++) {
+        for (size_t j = 0; j < in[0]->numel(); j++) {
+            *(c_ptr + i * in[0]->numel() + j) = (int64_t) (w[i] * (1 << 16));
+        }
+    }
+    coeff->scaling_factor() = 16;
+
+    Fix64N16 lhs(temp[0].get(), temp[1].get());
+    Fix64N16 result(temp[2].get(), temp[3].get());
+    lhs.polynomial(coeff.get(), &result);
+    result.reveal(out);
+}
+
+// break points {-1, 0, 1} for x[0 .. 2] and {-1, 0, 4} for x[3],
+// pieces: -1, x, 2x, 5
+void gen_poly_wise_multi(const std::vector<size_t>& in_shape,
+                         std::shared_ptr<TensorAdapter<int64_t>>& break_point,
+                         std::shared_ptr<TensorAdapter<int64_t>>& coeff) {
+    const size_t numel = in_shape[0];
+    const int64_t one = 1 << 16;
+    std::vector<size_t> shape = in_shape;
+    shape.insert(shape.begin(), 3);
+    break_point = gen(shape);
+    for (size_t j = 0; j < numel; ++j) {
+        break_point->data()[j] = -one;
+        break_point->data()[numel + j] = 0;
+        break_point->data()[2 * numel + j] = j == 3 ? 4 * one : one;
+    }
+    break_point->scaling_factor() = 16;
+
+    shape = in_shape;
+    shape.insert(shape.begin(), {4, 2});
+    coeff = gen(shape);
+    const int64_t c[4][2] = { {-one, 0}, {0, one}, {0, 2 * one}, {5 * one, 0} };
+    for (size_t i = 0; i < 4; ++i) {
+        for (size_t d = 0; d < 2; ++d) {
+            std::fill(coeff->data() + (i * 2 + d) * numel,
+                      coeff->data() + (i * 2 + d + 1) * numel, c[i][d]);
+        }
+    }
+    coeff->scaling_factor() = 16;
+}
+
+void test_fixedt_poly_wise_multi_fixed(size_t p,
+               std::vector<std::shared_ptr<TensorAdapter<int64_t>>> in,
+               TensorAdapter<int64_t>* out) {
+    std::vector<std::shared_ptr<TensorAdapter<int64_t>>> temp;
+    for (int i = 0; i < 4; i++) {
+        temp.emplace_back(gen(out->shape()));
+    }
+
+    test_fixedt_gen_shares(p, in[0], temp);
+    Fix64N16* lhs = new Fix64N16(temp[0].get(), temp[1].get());
+    Fix64N16* result = new Fix64N16(temp[2].get(), temp[3].get());
+
+    std::shared_ptr<TensorAdapter<int64_t>> break_point;
+    std::shared_ptr<TensorAdapter<int64_t>> coeff;
+    gen_poly_wise_multi(in[0]->shape(), break_point, coeff);
+
+    lhs->polynomial_piecewise(coeff.get(), break_point.get(), result);
+
+    result->reveal(out);
+}
+
 void test_fixedt_poly_wise_fixed(size_t p,
                std::vector<std::shared_ptr<TensorAdapter<int64_t>>> in,
                TensorAdapter<int64_t>* out) {
@@ -533,7 +708,9 @@ void test_fixedt_relu2_fixed(size_t p,
 
 void test_fixedt_softmax_fixed(size_t p,
                std::vector<std::shared_ptr<TensorAdapter<int64_t>>> in,
-               TensorAdapter<int64_t>* out) {
+               TensorAdapter<int64_t>* out,
+               bool use_relu = false,
+               bool use_goldschmidt_div = false) {
     std::vector<std::shared_ptr<TensorAdapter<int64_t>>> temp;
     for (int i = 0; i < 4; i++) {
         temp.emplace_back(gen(out->shape()));
@@ -543,7 +720,7 @@ void test_fixedt_softmax_fixed(size_t p,
 
     Fix64N16* lhs = new Fix64N16(temp[0].get(), temp[1].get());
     Fix64N16* result = new Fix64N16(temp[2].get(), temp[3].get());
-    lhs->softmax(result);
+    lhs->softmax(result, use_relu, true, use_goldschmidt_div);
     result->reveal(out);
 }
 
@@ -627,6 +804,22 @@ void test_fixedt_exp_fixed(size_t p,
     result->reveal(out);
 }
 
+void test_fixedt_exp_split_fixed(size_t p,
+               std::vector<std::shared_ptr<TensorAdapter<int64_t>>> in,
+               TensorAdapter<int64_t>* out) {
+    std::vector<std::shared_ptr<TensorAdapter<int64_t>>> temp;
+    for (int i = 0; i < 4; i++) {
+        temp.emplace_back(gen(out->shape()));
+    }
+
+    test_fixedt_gen_shares(p, in[0], temp);
+
+    Fix64N16* lhs = new Fix64N16(temp[0].get(), temp[1].get());
+    Fix64N16* result = new Fix64N16(temp[2].get(), temp[3].get());
+    lhs->exp_split(result);
+    result->reveal(out);
+}
+
 void test_fixedt_mat_mul_plain(size_t p,
                std::vector<std::shared_ptr<TensorAdapter<int64_t>>> in,
                TensorAdapter<int64_t>* out) {
@@ -914,6 +1107,25 @@ void test_fixedt_matmul_fixed(size_t p,
     result->reveal(out);
 }
 
+void test_fixedt_matmul_fixed_trans(size_t p,
+               std::vector<std::shared_ptr<TensorAdapter<int64_t>>> in,
+               TensorAdapter<int64_t>* out) {
+    std::vector<std::shared_ptr<TensorAdapter<int64_t>>> temp;
+    for (int i = 0; i < 4; i++) {
+        temp.emplace_back(gen(in[0]->shape()));
+    }
+    for (int i = 4; i < 6; i++) {
+        temp.emplace_back(gen(out->shape()));
+    }
+
+    test_fixedt_gen_shares(p, in, temp);
+    Fix64N16 lhs(temp[0].get(), temp[1].get());
+    Fix64N16 rhs(temp[2].get(), temp[3].get());
+    Fix64N16 result(temp[4].get(), temp[5].get());
+    lhs.mat_mul(&rhs, &result, true, false);
+    result.reveal(out);
+}
+
 void test_fixedt_precision_recall_fixed(size_t p,
                double threshold,
                std::vector<std::shared_ptr<TensorAdapter<int64_t>>> in,
@@ -999,6 +1211,53 @@ TEST_F(FixedTensorTest, matmulfixed) {
     EXPECT_TRUE(test_fixedt_check_tensor_eq(out0.get(), &result));
 }
 
+TEST_F(FixedTensorTest, matmulfixed_trans) {
+
+    std::vector<size_t> shape = {3, 2};
+    std::vector<size_t> shape_o = {2, 2};
+    std::vector<double> in0_val = {1, 2, 3, 4, 5, 6};
+    std::vector<double> in1_val = {1, 0, 0, 1, 1, 1};
+    std::vector<double> res_val = {6, 8, 8, 10};
+    std::vector<std::shared_ptr<TensorAdapter<int64_t>>> in =
+                            {gen(shape), gen(shape)};
+
+    test_fixedt_gen_paddle_tensor<int64_t, 16>(in0_val,
+                                shape, _cpu_ctx).copy(in[0].get());
+    test_fixedt_gen_paddle_tensor<int64_t, 16>(in1_val,
+                                shape, _cpu_ctx).copy(in[1].get());
+
+    auto out0 = _s_tensor_factory->create<int64_t>(shape_o);
+    auto out1 = _s_tensor_factory->create<int64_t>(shape_o);
+    auto out2 = _s_tensor_factory->create<int64_t>(shape_o);
+
+    PaddleTensor<int64_t> result =
+            test_fixedt_gen_paddle_tensor<int64_t, 16>(res_val, shape_o, _cpu_ctx);
+
+    _t[0] = std::thread([this, in, out0]() mutable {
+        g_ctx_holder::template run_with_context(_exec_ctx.get(), _mpc_ctx[0], [&](){
+            test_fixedt_matmul_fixed_trans(0, in, out0.get());
+        });
+    });
+    _t[1] = std::thread([this, in, out1]() mutable {
+        g_ctx_holder::template run_with_context(_exec_ctx.get(), _mpc_ctx[1], [&](){
+            test_fixedt_matmul_fixed_trans(1, in, out1.get());
+        });
+    });
+    _t[2] = std::thread([this, in, out2]() mutable {
+        g_ctx_holder::template run_with_context(_exec_ctx.get(), _mpc_ctx[2], [&](){
+            test_fixedt_matmul_fixed_trans(2, in, out2.get());
+        });
+    });
+
+    _t[0].join();
+    _t[1].join();
+    _t[2].join();
+
+    EXPECT_TRUE(test_fixedt_check_tensor_eq(out0.get(), out1.get()));
+    EXPECT_TRUE(test_fixedt_check_tensor_eq(out1.get(), out2.get()));
+    EXPECT_TRUE(test_fixedt_check_tensor_eq(out0.get(), &result));
+}
+
 TEST_F(FixedTensorTest, share) {
     std::vector<size_t> shape = {2, 2};
     std::vector<double> in_val = {1.0, 1.0, 1.0, 1.0};
@@ -1036,6 +1295,43 @@ TEST_F(FixedTensorTest, share) {
 }
 
 
+TEST_F(FixedTensorTest, online_share) {
+    std::vector<size_t> shape = {2, 2};
+    std::vector<double> in_val = {1.0, -2.5, 3.25, 0.0};
+    PaddleTensor<int64_t> input =
+            test_fixedt_gen_paddle_tensor<int64_t, 16>(in_val, shape, _cpu_ctx);
+    auto out0 = _s_tensor_factory->create<int64_t>(shape);
+    auto out1 = _s_tensor_factory->create<int64_t>(shape);
+    auto out2 = _s_tensor_factory->create<int64_t>(shape);
+    // party 1 owns the input, others use its shape only
+    PaddleTensor<int64_t> empty(&_cpu_ctx);
+    empty.reshape(shape);
+
+    _t[0] = std::thread([this, &empty, out0]() mutable {
+        g_ctx_holder::template run_with_context(_exec_ctx.get(), _mpc_ctx[0], [&](){
+            test_fixedt_online_share(0, 1, &empty, out0.get());
+        });
+    });
+    _t[1] = std::thread([this, &input, out1]() mutable {
+        g_ctx_holder::template run_with_context(_exec_ctx.get(), _mpc_ctx[1], [&](){
+            test_fixedt_online_share(1, 1, &input, out1.get());
+        });
+    });
+    _t[2] = std::thread([this, &empty, out2]() mutable {
+        g_ctx_holder::template run_with_context(_exec_ctx.get(), _mpc_ctx[2], [&](){
+            test_fixedt_online_share(2, 1, &empty, out2.get());
+        });
+    });
+
+    _t[0].join();
+    _t[1].join();
+    _t[2].join();
+
+    EXPECT_TRUE(test_fixedt_check_tensor_eq(out0.get(), &input));
+    EXPECT_TRUE(test_fixedt_check_tensor_eq(out1.get(), &input));
+    EXPECT_TRUE(test_fixedt_check_tensor_eq(out2.get(), &input));
+}
+
 TEST_F(FixedTensorTest, addfixed) {
 
     std::vector<size_t> shape = {2, 2};
@@ -1082,6 +1378,42 @@ TEST_F(FixedTensorTest, addfixed) {
     EXPECT_TRUE(test_fixedt_check_tensor_eq(out0.get(), &result));
 }
 
+TEST_F(FixedTensorTest, reveal_many) {
+
+    std::vector<size_t> shape = {2, 2};
+    std::vector<double> in0_val = {1.0, -2.0, 3.0, 4.5};
+    std::vector<double> in1_val = {-1.0, 8.0, 0.0, 2.25};
+    std::vector<std::shared_ptr<TensorAdapter<int64_t>>> in =
+                            {gen(shape), gen(shape)};
+
+    test_fixedt_gen_paddle_tensor<int64_t, 16>(in0_val,
+                                shape, _cpu_ctx).copy(in[0].get());
+    test_fixedt_gen_paddle_tensor<int64_t, 16>(in1_val,
+                                shape, _cpu_ctx).copy(in[1].get());
+
+    std::shared_ptr<TensorAdapter<int64_t>> out[6];
+    for (auto& o : out) {
+        o = _s_tensor_factory->create<int64_t>(shape);
+    }
+
+    for (size_t i = 0; i < 3; ++i) {
+        _t[i] = std::thread([this, i, in, &out]() mutable {
+            g_ctx_holder::template run_with_context(_exec_ctx.get(), _mpc_ctx[i], [&](){
+                test_fixedt_reveal_many(i, in, out[2 * i].get(), out[2 * i + 1].get());
+            });
+        });
+    }
+
+    _t[0].join();
+    _t[1].join();
+    _t[2].join();
+
+    for (size_t i = 0; i < 3; ++i) {
+        EXPECT_TRUE(test_fixedt_check_tensor_eq(out[2 * i].get(), in[0].get()));
+        EXPECT_TRUE(test_fixedt_check_tensor_eq(out[2 * i + 1].get(), in[1].get()));
+    }
+}
+
 TEST_F(FixedTensorTest, addplain) {
     std::vector<size_t> shape = {2, 2};
     std::vector<double> in0_val = {1.0, 5+2^-16, 1.0, 1.0};
@@ -1319,6 +1651,123 @@ TEST_F(FixedTensorTest, mulfixed) {
     EXPECT_TRUE(test_fixedt_check_tensor_eq(out0.get(), &result));
 }
 
+TEST_F(FixedTensorTest, mulfixed_ret_numel) {
+    // checked before any communication, so one party suffices
+    std::shared_ptr<TensorAdapter<int64_t>> t[6] = {
+        gen({2}), gen({2}), gen({2}), gen({2}), gen({1}), gen({1}) };
+    Fix64N16 lhs(t[0].get(), t[1].get());
+    Fix64N16 rhs(t[2].get(), t[3].get());
+    Fix64N16 ret(t[4].get(), t[5].get());
+
+    g_ctx_holder::template run_with_context(_exec_ctx.get(), _mpc_ctx[0], [&](){
+        EXPECT_THROW(lhs.mul(&rhs, &ret), ::paddle::platform::EnforceNotMet);
+    });
+}
+
+TEST_F(FixedTensorTest, mulfixed_preprocessed) {
+
+    std::vector<size_t> shape = {2, 2};
+    std::vector<double> in0_val = {1.5, -1.0, 0.25, 3.0};
+    std::vector<double> in1_val = {2.0, 2.0, -4.0, 0.5};
+    std::vector<double> res_val = {3.0, -2.0, -1.0, 1.5};
+
+    std::vector<std::shared_ptr<TensorAdapter<int64_t>>> in =
+                            {gen(shape), gen(shape)};
+
+    test_fixedt_gen_paddle_tensor<int64_t, 16>(in0_val,
+                                shape, _cpu_ctx).copy(in[0].get());
+    test_fixedt_gen_paddle_tensor<int64_t, 16>(in1_val,
+                                shape, _cpu_ctx).copy(in[1].get());
+
+    auto out0 = _s_tensor_factory->create<int64_t>(shape);
+    auto out1 = _s_tensor_factory->create<int64_t>(shape);
+    auto out2 = _s_tensor_factory->create<int64_t>(shape);
+    size_t pairs_left[3];
+
+    PaddleTensor<int64_t> result =
+            test_fixedt_gen_paddle_tensor<int64_t, 16>(res_val, shape, _cpu_ctx);
+
+    _t[0] = std::thread([this, in, out0, &pairs_left]() mutable {
+        g_ctx_holder::template run_with_context(_exec_ctx.get(), _mpc_ctx[0], [&](){
+            test_fixedt_mul_fixed_preprocessed(0, in, out0.get(), pairs_left);
+        });
+    });
+    _t[1] = std::thread([this, in, out1, &pairs_left]() mutable {
+        g_ctx_holder::template run_with_context(_exec_ctx.get(), _mpc_ctx[1], [&](){
+            test_fixedt_mul_fixed_preprocessed(1, in, out1.get(), pairs_left + 1);
+        });
+    });
+    _t[2] = std::thread([this, in, out2, &pairs_left]() mutable {
+        g_ctx_holder::template run_with_context(_exec_ctx.get(), _mpc_ctx[2], [&](){
+            test_fixedt_mul_fixed_preprocessed(2, in, out2.get(), pairs_left + 2);
+        });
+    });
+
+    _t[0].join();
+    _t[1].join();
+    _t[2].join();
+
+    EXPECT_TRUE(test_fixedt_check_tensor_eq(out0.get(), out1.get()));
+    EXPECT_TRUE(test_fixedt_check_tensor_eq(out1.get(), out2.get()));
+    EXPECT_TRUE(test_fixedt_check_tensor_eq(out0.get(), &result));
+    // mul consumes one pair per element
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_EQ(1u, pairs_left[i]);
+    }
+}
+
+TEST_F(FixedTensorTest, mulfixed_preprocess) {
+
+    std::vector<size_t> shape = {2, 2};
+    std::vector<double> in0_val = {1.5, -1.0, 0.25, 3.0};
+    std::vector<double> in1_val = {2.0, 2.0, -4.0, 0.5};
+    std::vector<double> res_val = {3.0, -2.0, -1.0, 1.5};
+
+    std::vector<std::shared_ptr<TensorAdapter<int64_t>>> in =
+                            {gen(shape), gen(shape)};
+
+    test_fixedt_gen_paddle_tensor<int64_t, 16>(in0_val,
+                                shape, _cpu_ctx).copy(in[0].get());
+    test_fixedt_gen_paddle_tensor<int64_t, 16>(in1_val,
+                                shape, _cpu_ctx).copy(in[1].get());
+
+    std::shared_ptr<TensorAdapter<int64_t>> out[3][3];
+    TensorAdapter<int64_t>* out_ptr[3][3];
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            out[i][j] = _s_tensor_factory->create<int64_t>(shape);
+            out_ptr[i][j] = out[i][j].get();
+        }
+    }
+    size_t left[3][3];
+
+    PaddleTensor<int64_t> result =
+            test_fixedt_gen_paddle_tensor<int64_t, 16>(res_val, shape, _cpu_ctx);
+
+    for (int i = 0; i < 3; ++i) {
+        _t[i] = std::thread([this, in, i, &out_ptr, &left]() mutable {
+            g_ctx_holder::template run_with_context(_exec_ctx.get(), _mpc_ctx[i], [&](){
+                test_fixedt_mul_fixed_preprocess(i, in, out_ptr[i], left[i]);
+            });
+        });
+    }
+    for (int i = 0; i < 3; ++i) {
+        _t[i].join();
+    }
+
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            EXPECT_TRUE(test_fixedt_check_tensor_eq(out_ptr[i][j], &result));
+        }
+        // one pair per element
+        EXPECT_EQ(4u, left[i][0]);
+        // all consumed
+        EXPECT_EQ(0u, left[i][1]);
+        // file removed on load
+        EXPECT_EQ(0u, left[i][2]);
+    }
+}
+
 #ifndef USE_ABY3_TRUNC1 //use aby3 trunc1
 TEST_F(FixedTensorTest, mulfixed_multi_times) {
 
@@ -1627,7 +2076,56 @@ TEST_F(FixedTensorTest, divplain) {
     });
     _t[2] = std::thread([this, in, out2]() mutable {
         g_ctx_holder::template run_with_context(_exec_ctx.get(), _mpc_ctx[2], [&](){
-            test_fixedt_div_plain(2, in, out2.get());
+            test_fixedt_div_plain(2, in, out2.get());
+        });
+
+    });
+
+    _t[0].join();
+    _t[1].join();
+    _t[2].join();
+
+    EXPECT_TRUE(test_fixedt_check_tensor_eq(out0.get(), out1.get()));
+    EXPECT_TRUE(test_fixedt_check_tensor_eq(out1.get(), out2.get()));
+    EXPECT_TRUE(test_fixedt_check_tensor_eq(out0.get(), &result));
+}
+
+TEST_F(FixedTensorTest, divfixed) {
+
+    std::vector<size_t> shape = {2, 2};
+    std::vector<double> in0_val = {1.0, 1.0, 1.0, 1.0};
+    std::vector<double> in1_val = {1.0, 10.0, 1000.0, 700.0};
+    std::vector<double> res_val = {1.0, 0.1, 0.001, 1.0 / 700};
+    std::vector<std::shared_ptr<TensorAdapter<int64_t>>> in =
+                            {gen(shape), gen(shape)};
+
+    test_fixedt_gen_paddle_tensor<int64_t, 16>(in0_val,
+                                shape, _cpu_ctx).copy(in[0].get());
+    test_fixedt_gen_paddle_tensor<int64_t, 16>(in1_val,
+                                shape, _cpu_ctx).copy(in[1].get());
+
+    auto out0 = _s_tensor_factory->create<int64_t>(shape);
+    auto out1 = _s_tensor_factory->create<int64_t>(shape);
+    auto out2 = _s_tensor_factory->create<int64_t>(shape);
+
+    PaddleTensor<int64_t> result =
+            test_fixedt_gen_paddle_tensor<int64_t, 16>(res_val, shape, _cpu_ctx);
+
+    _t[0] = std::thread([this, in, out0]() mutable {
+        g_ctx_holder::template run_with_context(_exec_ctx.get(), _mpc_ctx[0], [&](){
+            test_fixedt_div_fixed(0, in, out0.get());
+        });
+
+    });
+    _t[1] = std::thread([this, in, out1]() mutable {
+        g_ctx_holder::template run_with_context(_exec_ctx.get(), _mpc_ctx[1], [&](){
+            test_fixedt_div_fixed(1, in, out1.get());
+        });
+
+    });
+    _t[2] = std::thread([this, in, out2]() mutable {
+        g_ctx_holder::template run_with_context(_exec_ctx.get(), _mpc_ctx[2], [&](){
+            test_fixedt_div_fixed(2, in, out2.get());
         });
 
     });
@@ -1638,15 +2136,15 @@ TEST_F(FixedTensorTest, divplain) {
 
     EXPECT_TRUE(test_fixedt_check_tensor_eq(out0.get(), out1.get()));
     EXPECT_TRUE(test_fixedt_check_tensor_eq(out1.get(), out2.get()));
-    EXPECT_TRUE(test_fixedt_check_tensor_eq(out0.get(), &result));
+    EXPECT_TRUE(test_fixedt_check_tensor_eq(out0.get(), &result, 0.2, true));
 }
 
-TEST_F(FixedTensorTest, divfixed) {
+TEST_F(FixedTensorTest, goldschmidt_div) {
 
-    std::vector<size_t> shape = {2, 2};
-    std::vector<double> in0_val = {1.0, 1.0, 1.0, 1.0};
-    std::vector<double> in1_val = {1.0, 10.0, 1000.0, 700.0};
-    std::vector<double> res_val = {1.0, 0.1, 0.001, 1.0 / 700};
+    std::vector<size_t> shape = {2, 3};
+    std::vector<double> in0_val = {1.0, -3.0, 2.5, 100.0, 1000.0, 5000.0};
+    std::vector<double> in1_val = {3.0, 1.0 / 64, -7.0, 1000.0, 0.125, 60000.0};
+    std::vector<double> res_val = {1.0 / 3, -192.0, -2.5 / 7, 0.1, 8000.0, 5000.0 / 60000};
     std::vector<std::shared_ptr<TensorAdapter<int64_t>>> in =
                             {gen(shape), gen(shape)};
 
@@ -1664,19 +2162,19 @@ TEST_F(FixedTensorTest, divfixed) {
 
     _t[0] = std::thread([this, in, out0]() mutable {
         g_ctx_holder::template run_with_context(_exec_ctx.get(), _mpc_ctx[0], [&](){
-            test_fixedt_div_fixed(0, in, out0.get());
+            test_fixedt_goldschmidt_div_fixed(0, in, out0.get());
         });
 
     });
     _t[1] = std::thread([this, in, out1]() mutable {
         g_ctx_holder::template run_with_context(_exec_ctx.get(), _mpc_ctx[1], [&](){
-            test_fixedt_div_fixed(1, in, out1.get());
+            test_fixedt_goldschmidt_div_fixed(1, in, out1.get());
         });
 
     });
     _t[2] = std::thread([this, in, out2]() mutable {
         g_ctx_holder::template run_with_context(_exec_ctx.get(), _mpc_ctx[2], [&](){
-            test_fixedt_div_fixed(2, in, out2.get());
+            test_fixedt_goldschmidt_div_fixed(2, in, out2.get());
         });
 
     });
@@ -1687,7 +2185,7 @@ TEST_F(FixedTensorTest, divfixed) {
 
     EXPECT_TRUE(test_fixedt_check_tensor_eq(out0.get(), out1.get()));
     EXPECT_TRUE(test_fixedt_check_tensor_eq(out1.get(), out2.get()));
-    EXPECT_TRUE(test_fixedt_check_tensor_eq(out0.get(), &result, 0.2, true));
+    EXPECT_TRUE(test_fixedt_check_tensor_eq(out0.get(), &result, 0.001, true));
 }
 
 TEST_F(FixedTensorTest, divfixed_low_bound) {
@@ -2169,6 +2667,93 @@ TEST_F(FixedTensorTest, lt_fixed) {
     EXPECT_TRUE(test_fixedt_check_tensor_eq(out0.get(), &result));
 }
 
+TEST_F(FixedTensorTest, lt_batch_test) {
+    // more than one batch of bit-planes in total
+    std::vector<size_t> shape0 = { 100 };
+    std::vector<size_t> shape1 = { 2, 50 };
+
+    std::shared_ptr<TensorAdapter<int64_t>> sl[2][3] = {
+        { gen(shape0), gen(shape0), gen(shape0) },
+        { gen(shape1), gen(shape1), gen(shape1) } };
+    std::shared_ptr<TensorAdapter<int64_t>> sr[2][3] = {
+        { gen(shape0), gen(shape0), gen(shape0) },
+        { gen(shape1), gen(shape1), gen(shape1) } };
+    std::shared_ptr<TensorAdapter<int64_t>> sout[2][6] = {
+        { gen(shape0), gen(shape0), gen(shape0),
+          gen(shape0), gen(shape0), gen(shape0) },
+        { gen(shape1), gen(shape1), gen(shape1),
+          gen(shape1), gen(shape1), gen(shape1) } };
+
+    std::mt19937_64 rng(0);
+    for (int k = 0; k < 2; ++k) {
+        for (int j = 0; j < 3; ++j) {
+            for (size_t i = 0; i < 100; ++i) {
+                // values within +- 2^40, random shares
+                sl[k][j]->data()[i] = j == 0 ? rng() % (1ll << 41) - (1ll << 40) : 0;
+                sr[k][j]->data()[i] = j == 0 ? rng() % (1ll << 41) - (1ll << 40) : 0;
+            }
+        }
+        // ties
+        sr[k][0]->data()[0] = sl[k][0]->data()[0];
+        for (size_t i = 0; i < 100; ++i) {
+            int64_t r = rng();
+            sl[k][0]->data()[i] -= r;
+            sl[k][1]->data()[i] += r;
+            r = rng();
+            sr[k][0]->data()[i] -= r;
+            sr[k][2]->data()[i] += r;
+        }
+    }
+    std::vector<int64_t> expected[2];
+    for (int k = 0; k < 2; ++k) {
+        for (size_t i = 0; i < 100; ++i) {
+            int64_t l = sl[k][0]->data()[i] + sl[k][1]->data()[i] + sl[k][2]->data()[i];
+            int64_t r = sr[k][0]->data()[i] + sr[k][1]->data()[i] + sr[k][2]->data()[i];
+            expected[k].emplace_back(l < r);
+        }
+    }
+
+    auto p0 = gen(shape0);
+    auto p1 = gen(shape1);
+
+    std::vector<std::shared_ptr<Fix64N16>> fl[3];
+    std::vector<std::shared_ptr<Fix64N16>> fr[3];
+    std::vector<std::shared_ptr<BooleanTensor<int64_t>>> bout[3];
+    for (int j = 0; j < 3; ++j) {
+        for (int k = 0; k < 2; ++k) {
+            fl[j].emplace_back(std::make_shared<Fix64N16>(
+                sl[k][j].get(), sl[k][(j + 1) % 3].get()));
+            fr[j].emplace_back(std::make_shared<Fix64N16>(
+                sr[k][j].get(), sr[k][(j + 1) % 3].get()));
+            bout[j].emplace_back(std::make_shared<BooleanTensor<int64_t>>(
+                sout[k][2 * j].get(), sout[k][2 * j + 1].get()));
+        }
+    }
+
+    for (int j = 0; j < 3; ++j) {
+        _t[j] = std::thread(
+            [&, j] () {
+            g_ctx_holder::template run_with_context(
+                _exec_ctx.get(), _mpc_ctx[j], [&](){
+                    Fix64N16::lt({ fl[j][0].get(), fl[j][1].get() },
+                                 { fr[j][0].get(), fr[j][1].get() },
+                                 { bout[j][0].get(), bout[j][1].get() });
+                    bout[j][0]->reveal_to_one(0, j == 0 ? p0.get() : nullptr);
+                    bout[j][1]->reveal_to_one(0, j == 0 ? p1.get() : nullptr);
+                });
+            }
+        );
+    }
+    for (auto &t: _t) {
+        t.join();
+    }
+
+    for (size_t i = 0; i < 100; ++i) {
+        EXPECT_EQ(expected[0][i], p0->data()[i]);
+        EXPECT_EQ(expected[1][i], p1->data()[i]);
+    }
+}
+
 TEST_F(FixedTensorTest, leq_plain) {
 
     std::vector<size_t> shape = {2, 2};
@@ -2641,6 +3226,60 @@ TEST_F(FixedTensorTest, exp_fixed) {
     EXPECT_TRUE(test_fixedt_check_tensor_eq(out0.get(), &result, 0.01, true));
 }
 
+TEST_F(FixedTensorTest, exp_split_fixed) {
+
+    std::vector<size_t> shape = {2, 4};
+    // clamped into [-16, 16) after * log2(e)
+    std::vector<double> in0_val = {-20.0, -5.5, -0.3, 0.0, 1.0, 2.5, 7.25, 20.0};
+    std::vector<std::shared_ptr<TensorAdapter<int64_t>>> in = {gen(shape)};
+
+    test_fixedt_gen_paddle_tensor<int64_t, 16>(in0_val,
+                                shape, _cpu_ctx).copy(in[0].get());
+    //not copy scaling factor in copy funtion
+    dynamic_cast<PaddleTensor<int64_t>*>(in[0].get())->
+                                scaling_factor() = 16;
+
+    auto out0 = _s_tensor_factory->create<int64_t>(shape);
+    auto out1 = _s_tensor_factory->create<int64_t>(shape);
+    auto out2 = _s_tensor_factory->create<int64_t>(shape);
+
+    _t[0] = std::thread([this, in, out0]() mutable {
+        g_ctx_holder::template run_with_context(_exec_ctx.get(), _mpc_ctx[0], [&](){
+            test_fixedt_exp_split_fixed(0, in, out0.get());
+        });
+
+    });
+    _t[1] = std::thread([this, in, out1]() mutable {
+        g_ctx_holder::template run_with_context(_exec_ctx.get(), _mpc_ctx[1], [&](){
+            test_fixedt_exp_split_fixed(1, in, out1.get());
+        });
+
+    });
+    _t[2] = std::thread([this, in, out2]() mutable {
+        g_ctx_holder::template run_with_context(_exec_ctx.get(), _mpc_ctx[2], [&](){
+            test_fixedt_exp_split_fixed(2, in, out2.get());
+        });
+
+    });
+
+    _t[0].join();
+    _t[1].join();
+    _t[2].join();
+
+    EXPECT_TRUE(test_fixedt_check_tensor_eq(out0.get(), out1.get()));
+    EXPECT_TRUE(test_fixedt_check_tensor_eq(out1.get(), out2.get()));
+    for (size_t i = 0; i < in0_val.size(); ++i) {
+        double expected = std::exp(in0_val[i]);
+        if (expected < 0x1p-16) {
+            expected = 0;
+        } else if (expected >= 0x1p16) {
+            expected = 0x1p16;
+        }
+        EXPECT_NEAR(expected, out0->data()[i] / 0x1p16,
+                    0.0001 * expected + 4 / 0x1p16);
+    }
+}
+
 TEST_F(FixedTensorTest, exp_fixed_low_bound) {
 
     std::vector<size_t> shape = {1, 3};
@@ -2789,6 +3428,56 @@ TEST_F(FixedTensorTest, polynomial) {
     EXPECT_TRUE(test_fixedt_check_tensor_eq(out0.get(), &result));
 }
 
+TEST_F(FixedTensorTest, polynomial_degree5) {
+    // y = 1 - x + 0.5x^2 + x^3 - 0.25x^4 + 0.125x^5
+    std::vector<double> w = {1, -1, 0.5, 1, -0.25, 0.125};
+    std::vector<size_t> shape = {2, 2};
+    std::vector<double> in0_val = {-1.0, 0.5, 1.5, 2.0};
+    std::vector<double> res_val;
+    for (auto x : in0_val) {
+        double y = 0;
+        for (size_t i = 0; i < w.size(); ++i) {
+            y += w[i] * std::pow(x, i);
+        }
+        res_val.emplace_back(y);
+    }
+    std::vector<std::shared_ptr<TensorAdapter<int64_t>>> in = {gen(shape)};
+
+    test_fixedt_gen_paddle_tensor<int64_t, 16>(in0_val,
+                                shape, _cpu_ctx).copy(in[0].get());
+
+    auto out0 = _s_tensor_factory->create<int64_t>(shape);
+    auto out1 = _s_tensor_factory->create<int64_t>(shape);
+    auto out2 = _s_tensor_factory->create<int64_t>(shape);
+
+    PaddleTensor<int64_t> result =
+            test_fixedt_gen_paddle_tensor<int64_t, 16>(res_val, shape, _cpu_ctx);
+
+    _t[0] = std::thread([this, in, &w, out0]() mutable {
+        g_ctx_holder::template run_with_context(_exec_ctx.get(), _mpc_ctx[0], [&](){
+            test_fixedt_poly_fixed_coeff(0, in, w, out0.get());
+        });
+    });
+    _t[1] = std::thread([this, in, &w, out1]() mutable {
+        g_ctx_holder::template run_with_context(_exec_ctx.get(), _mpc_ctx[1], [&](){
+            test_fixedt_poly_fixed_coeff(1, in, w, out1.get());
+        });
+    });
+    _t[2] = std::thread([this, in, &w, out2]() mutable {
+        g_ctx_holder::template run_with_context(_exec_ctx.get(), _mpc_ctx[2], [&](){
+            test_fixedt_poly_fixed_coeff(2, in, w, out2.get());
+        });
+    });
+
+    _t[0].join();
+    _t[1].join();
+    _t[2].join();
+
+    EXPECT_TRUE(test_fixedt_check_tensor_eq(out0.get(), out1.get()));
+    EXPECT_TRUE(test_fixedt_check_tensor_eq(out1.get(), out2.get()));
+    EXPECT_TRUE(test_fixedt_check_tensor_eq(out0.get(), &result, 0.001));
+}
+
 TEST_F(FixedTensorTest, polynomial_wise) {
     // y = x + 1 (x >= 0)
     // y = 1 (x < 0)
@@ -2839,6 +3528,58 @@ TEST_F(FixedTensorTest, polynomial_wise) {
     EXPECT_TRUE(test_fixedt_check_tensor_eq(out0.get(), &result));
 }
 
+TEST_F(FixedTensorTest, polynomial_wise_multi) {
+    std::vector<size_t> shape = {4};
+    std::vector<double> in0_val = {-3.0, -0.5, 0.5, 3.0};
+    std::vector<double> res_val = {-1.0, -0.5, 1.0, 6.0};
+    std::vector<std::shared_ptr<TensorAdapter<int64_t>>> in = {gen(shape)};
+
+    test_fixedt_gen_paddle_tensor<int64_t, 16>(in0_val,
+                                shape, _cpu_ctx).copy(in[0].get());
+    dynamic_cast<PaddleTensor<int64_t>*>(in[0].get())->
+                                scaling_factor() = 16;
+
+    std::shared_ptr<TensorAdapter<int64_t>> out[3] = {
+        gen(shape), gen(shape), gen(shape) };
+
+    PaddleTensor<int64_t> result =
+            test_fixedt_gen_paddle_tensor<int64_t, 16>(res_val, shape, _cpu_ctx);
+
+    for (size_t i = 0; i < 3; ++i) {
+        _t[i] = std::thread([this, in, &out, i]() mutable {
+            g_ctx_holder::template run_with_context(_exec_ctx.get(), _mpc_ctx[i], [&](){
+                test_fixedt_poly_wise_multi_fixed(i, in, out[i].get());
+            });
+        });
+    }
+    for (auto& t : _t) {
+        t.join();
+    }
+
+    EXPECT_TRUE(test_fixedt_check_tensor_eq(out[0].get(), out[1].get()));
+    EXPECT_TRUE(test_fixedt_check_tensor_eq(out[1].get(), out[2].get()));
+    EXPECT_TRUE(test_fixedt_check_tensor_eq(out[0].get(), &result));
+}
+
+TEST_F(FixedTensorTest, polynomial_wise_unordered) {
+    // checked before any communication, so one party suffices
+    std::vector<size_t> shape = {4};
+    std::shared_ptr<TensorAdapter<int64_t>> t[4] = {
+        gen(shape), gen(shape), gen(shape), gen(shape) };
+    Fix64N16 x(t[0].get(), t[1].get());
+    Fix64N16 ret(t[2].get(), t[3].get());
+
+    g_ctx_holder::template run_with_context(_exec_ctx.get(), _mpc_ctx[0], [&](){
+        std::shared_ptr<TensorAdapter<int64_t>> break_point;
+        std::shared_ptr<TensorAdapter<int64_t>> coeff;
+        gen_poly_wise_multi(shape, break_point, coeff);
+        // 2nd break point of x[1] below its 1st
+        break_point->data()[4 + 1] = -2 << 16;
+        EXPECT_THROW(x.polynomial_piecewise(coeff.get(), break_point.get(), &ret),
+                     ::paddle::platform::EnforceNotMet);
+    });
+}
+
 TEST_F(FixedTensorTest, relu) {
 
     std::vector<size_t> shape = {2, 2};
@@ -3082,6 +3823,50 @@ TEST_F(FixedTensorTest, softmax) {
     EXPECT_TRUE(test_fixedt_check_tensor_eq(out0.get(), &result, 0.1));
 }
 
+void test_softmax_div_mode(FixedTensorTest* test,
+                           std::vector<double> in_val,
+                           std::vector<double> res_val,
+                           bool use_relu) {
+    std::vector<size_t> shape = {2, 2};
+    std::vector<std::shared_ptr<TensorAdapter<int64_t>>> in = {test->gen(shape)};
+
+    test_fixedt_gen_paddle_tensor<int64_t, 16>(in_val,
+                                shape, test->_cpu_ctx).copy(in[0].get());
+    dynamic_cast<PaddleTensor<int64_t>*>(in[0].get())->
+                                scaling_factor() = 16;
+
+    std::shared_ptr<TensorAdapter<int64_t>> out[3] = {
+        test->gen(shape), test->gen(shape), test->gen(shape) };
+
+    PaddleTensor<int64_t> result =
+            test_fixedt_gen_paddle_tensor<int64_t, 16>(res_val, shape, test->_cpu_ctx);
+
+    for (size_t i = 0; i < 3; ++i) {
+        test->_t[i] = std::thread([test, in, &out, i, use_relu]() mutable {
+            g_ctx_holder::template run_with_context(
+                test->_exec_ctx.get(), test->_mpc_ctx[i], [&](){
+                test_fixedt_softmax_fixed(i, in, out[i].get(), use_relu, true);
+            });
+        });
+    }
+    for (auto& t : test->_t) {
+        t.join();
+    }
+
+    EXPECT_TRUE(test_fixedt_check_tensor_eq(out[0].get(), &result, 0.01));
+}
+
+TEST_F(FixedTensorTest, softmax_goldschmidt_div) {
+    test_softmax_div_mode(this, {1, 2, 3, 0},
+                          {0.2689, 0.7311, 0.9526, 0.0474}, false);
+}
+
+TEST_F(FixedTensorTest, softmax_relu_large_sum) {
+    // goldschmidt_div is not used for unbounded sum of relu
+    test_softmax_div_mode(this, {40000, 40000, 1, 3},
+                          {0.5, 0.5, 0.25, 0.75}, true);
+}
+
 TEST_F(FixedTensorTest, sigmoid_chebyshev) {
 
     std::vector<size_t> shape = {2, 2};
@@ -3480,6 +4265,81 @@ TEST_F(FixedTensorTest, max_pooling_test) {
     EXPECT_EQ(0, ppos->data()[3]);
 }
 
+TEST_F(FixedTensorTest, max_pooling_odd_test) {
+    std::vector<size_t> shape = { 5, 2 };
+    std::vector<size_t> shape_ = { 1, 2 };
+
+    std::shared_ptr<TensorAdapter<int64_t>> sl[3] = { gen(shape), gen(shape), gen(shape) };
+    std::shared_ptr<TensorAdapter<int64_t>> sfout[6] = {
+        gen(shape_), gen(shape_), gen(shape_), gen(shape_), gen(shape_), gen(shape_)};
+    std::shared_ptr<TensorAdapter<int64_t>> sbout[6] = {
+        gen(shape), gen(shape), gen(shape), gen(shape), gen(shape), gen(shape)};
+
+    assign_to_tensor(sl[1].get(), 0l);
+    assign_to_tensor(sl[2].get(), 0l);
+    // input col 0 [1 5 3 5 2], tie goes to first one
+    // input col 1 [-1 -4 -2 -3 7], largest one is carried to last level
+    int64_t in[10] = { 1, -1, 5, -4, 3, -2, 5, -3, 2, 7 };
+    std::copy(in, in + 10, sl[0]->data());
+
+    auto pmax = gen(shape_);
+    auto ppos = gen(shape);
+
+    Fix64N16 fl0(sl[0].get(), sl[1].get());
+    Fix64N16 fl1(sl[1].get(), sl[2].get());
+    Fix64N16 fl2(sl[2].get(), sl[0].get());
+
+    Fix64N16 fout0(sfout[0].get(), sfout[1].get());
+    Fix64N16 fout1(sfout[2].get(), sfout[3].get());
+    Fix64N16 fout2(sfout[4].get(), sfout[5].get());
+
+    BooleanTensor<int64_t> bout0(sbout[0].get(), sbout[1].get());
+    BooleanTensor<int64_t> bout1(sbout[2].get(), sbout[3].get());
+    BooleanTensor<int64_t> bout2(sbout[4].get(), sbout[5].get());
+
+    _t[0] = std::thread(
+        [&] () {
+        g_ctx_holder::template run_with_context(
+            _exec_ctx.get(), _mpc_ctx[0], [&](){
+                fl0.max_pooling(&fout0, &bout0);
+                fout0.reveal_to_one(0, pmax.get());
+                bout0.reveal_to_one(0, ppos.get());
+            });
+        }
+    );
+    _t[1] = std::thread(
+        [&] () {
+        g_ctx_holder::template run_with_context(
+            _exec_ctx.get(), _mpc_ctx[1], [&](){
+                fl1.max_pooling(&fout1, &bout1);
+                fout1.reveal_to_one(0, nullptr);
+                bout1.reveal_to_one(0, nullptr);
+            });
+        }
+    );
+    _t[2] = std::thread(
+        [&] () {
+        g_ctx_holder::template run_with_context(
+            _exec_ctx.get(), _mpc_ctx[2], [&](){
+                fl2.max_pooling(&fout2, &bout2);
+                fout2.reveal_to_one(0, nullptr);
+                bout2.reveal_to_one(0, nullptr);
+            });
+        }
+    );
+    for (auto &t: _t) {
+        t.join();
+    }
+
+    EXPECT_EQ(5, pmax->data()[0]);
+    EXPECT_EQ(7, pmax->data()[1]);
+
+    int64_t pos[10] = { 0, 0, 1, 0, 0, 0, 0, 0, 0, 1 };
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQ(pos[i], ppos->data()[i]);
+    }
+}
+
 TEST_F(FixedTensorTest, inv_sqrt_test) {
     std::vector<size_t> shape = { 1 };
 
@@ -3538,6 +4398,68 @@ TEST_F(FixedTensorTest, inv_sqrt_test) {
 
 }
 
+TEST_F(FixedTensorTest, inv_sqrt_normalized_test) {
+    std::vector<size_t> shape = { 10 };
+    std::vector<double> in = { 0.01, 0.3, 1, 4, 1000, 30000,
+                               65536, 1e6, 3e6, 1e9 };
+
+    std::shared_ptr<TensorAdapter<int64_t>> sl[3] = { gen(shape), gen(shape), gen(shape) };
+    std::shared_ptr<TensorAdapter<int64_t>> sfout[6] = {
+        gen(shape), gen(shape), gen(shape), gen(shape), gen(shape), gen(shape)};
+
+    for (size_t i = 0; i < in.size(); ++i) {
+        sl[0]->data()[i] = in[i] * 0x1p16;
+        sl[1]->data()[i] = 0;
+        sl[2]->data()[i] = 0;
+    }
+
+    auto p = gen(shape);
+
+    Fix64N16 fl0(sl[0].get(), sl[1].get());
+    Fix64N16 fl1(sl[1].get(), sl[2].get());
+    Fix64N16 fl2(sl[2].get(), sl[0].get());
+
+    Fix64N16 fout0(sfout[0].get(), sfout[1].get());
+    Fix64N16 fout1(sfout[2].get(), sfout[3].get());
+    Fix64N16 fout2(sfout[4].get(), sfout[5].get());
+
+    _t[0] = std::thread(
+        [&] () {
+        g_ctx_holder::template run_with_context(
+            _exec_ctx.get(), _mpc_ctx[0], [&](){
+                fl0.inverse_square_root_normalized(&fout0);
+                fout0.reveal_to_one(0, p.get());
+            });
+        }
+    );
+    _t[1] = std::thread(
+        [&] () {
+        g_ctx_holder::template run_with_context(
+            _exec_ctx.get(), _mpc_ctx[1], [&](){
+                fl1.inverse_square_root_normalized(&fout1);
+                fout1.reveal_to_one(0, nullptr);
+            });
+        }
+    );
+    _t[2] = std::thread(
+        [&] () {
+        g_ctx_holder::template run_with_context(
+            _exec_ctx.get(), _mpc_ctx[2], [&](){
+                fl2.inverse_square_root_normalized(&fout2);
+                fout2.reveal_to_one(0, nullptr);
+            });
+        }
+    );
+    for (auto &t: _t) {
+        t.join();
+    }
+
+    for (size_t i = 0; i < in.size(); ++i) {
+        double expected = 1 / std::sqrt(in[i]);
+        EXPECT_NEAR(expected, p->data()[i] / 0x1p16, 0.001 * expected + 4 / 0x1p16);
+    }
+}
+
 #ifdef USE_ABY3_TRUNC1 //use aby3 trunc1
 TEST_F(FixedTensorTest, truncate1_msb_incorrect) {
     std::vector<size_t> shape = { 1 };
@@ -165,21 +165,33 @@ def reveal(input, name=None):
     """
     reveal operator.
     Args:
-        input (MpcVariable): The input Tensor/LoDTensor of reveal_op.
-        name (string, optional): Name of the output. Default is None. It is used to print debug info for developers.
+        input (MpcVariable|list): The input Tensor/LoDTensor of reveal_op, or a list of them, which are revealed in one round.
+        name (string|list, optional): Name of the output, or a list of names for a list of inputs. Default is None. It is used to print debug info for developers.
     Returns:
-       MpcVariable(Tensor/LoDTensor): The output Tensor/LoDTensor of reveal op.
+       MpcVariable(Tensor/LoDTensor)|list: The output Tensor/LoDTensor of reveal op, or a list of them for a list of inputs.
     """
 
-    check_mpc_variable_and_dtype(input, 'input', ['int64'], 'reveal')
-    inputs = {'X': [input]}
+    is_list = isinstance(input, (list, tuple))
+    input_list = list(input) if is_list else [input]
+    for x in input_list:
+        check_mpc_variable_and_dtype(x, 'input', ['int64'], 'reveal')
+    inputs = {'X': input_list}
     helper = MpcLayerHelper('reveal', **locals())
     if name is None:
-        out = helper.create_variable_for_type_inference(dtype='float32', stop_gradient=True)
+        outs = [
+            helper.create_variable_for_type_inference(
+                dtype='float32', stop_gradient=True) for _ in input_list
+        ]
     else:
-        out = helper.create_variable(
-            name=name, dtype='float32', persistable=False, stop_gradient=True)
+        names = list(name) if is_list else [name]
+        outs = [
+            helper.create_variable(
+                name=n, dtype='float32', persistable=False, stop_gradient=True)
+            for n in names
+        ]
 
     helper.append_op(
-        type='mpc_reveal', inputs=inputs, outputs={'Out': out})
-    return helper.append_activation(out)
+        type='mpc_reveal', inputs=inputs, outputs={'Out': outs})
+    if is_list:
+        return outs
+    return helper.append_activation(outs[0])
@@ -288,7 +288,9 @@ def softmax_with_cross_entropy(logits,
                                return_softmax=False,
                                axis=-1,
                                use_relu=False,
-                               use_long_div=True):
+                               use_long_div=True,
+                               use_goldschmidt_div=False,
+                               use_split_exp=False):
     """
     forward: out = softmax(x). todo: add cross_entropy
     backward: dx = dout.expand * (softmax(x) - label)
@@ -301,13 +303,23 @@ def softmax_with_cross_entropy(logits,
                   False: find inverse of divisor by Newton's method.
                          fast with low precision.
                          range of divisor: (0, 2^15).
+    use_goldschmidt_div: False(default): divide as use_long_div says.
+                         True: divide sum of exp by goldschmidt division,
+                               high precision in fewer rounds than long division.
+                               range of divisor: [2^-16, 2^16).
+                               ignored if use_relu is True, whose sum is unbounded.
+    use_split_exp: False(default): exp(x) = (1 + x / n)^n, input clamped to [-64, 0].
+                   True: exp by splitting x into integer and fractional parts,
+                         more accurate with fewer dependent rounds.
     """
 
     attrs = {
         'soft_label': soft_label,
         'axis': axis,
         'use_relu': use_relu,
-        'use_long_div': use_long_div
+        'use_long_div': use_long_div,
+        'use_goldschmidt_div': use_goldschmidt_div,
+        'use_split_exp': use_split_exp
     }
 
     helper = MpcLayerHelper('softmax_with_cross_entropy', **locals())
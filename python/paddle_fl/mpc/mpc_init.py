@@ -15,12 +15,13 @@
 mpc instance initialized..
 """
 
+import contextlib
 import numpy
 import paddle.fluid as fluid
 from .mpc_layer_helper import MpcLayerHelper
 from .framework import MpcProtocols
 
-__all__ = ['init', ]
+__all__ = ['init', 'channel_guard', ]
 
 def init(protocol_name,
          role,
@@ -29,6 +30,9 @@ def init(protocol_name,
          net_server_port=None,
          endpoints=None,
          network_mode="gloo",
+         enable_comm_stats=False,
+         coalesce_sends=False,
+         preprocessing_file="",
          name=None):
     """
     init operator.
@@ -39,6 +43,13 @@ def init(protocol_name,
     net_server_addr (string):
     net_server_port (int):
     endpoints (string):
+    network_mode (string): gloo, grpc, grpc_stream, tcp or shm
+    enable_comm_stats (bool): count traffic of each op, which can be
+        read by mpc_data_utils.comm_stats()
+    coalesce_sends (bool): batch msgs to a peer into one until next recv
+    preprocessing_file (string): aby3 only, load randomness preprocessed
+        ahead of time from file "<preprocessing_file>.<role>", which is
+        removed after loaded
     """
     mpc_protocol_index = MpcProtocols[protocol_name.upper()].value
     fluid.global_scope().var("mpc_protocol_index").get_tensor().set(
@@ -54,5 +65,32 @@ def init(protocol_name,
             "net_server_addr": net_server_addr,
             "net_server_port": net_server_port,
             "endpoints": endpoints,
-            "network_mode": network_mode
+            "network_mode": network_mode,
+            "enable_comm_stats": enable_comm_stats,
+            "coalesce_sends": coalesce_sends,
+            "preprocessing_file": preprocessing_file
         })
+
+
+@contextlib.contextmanager
+def channel_guard(channel, program=None):
+    """
+    Run mpc ops appended in this guard on network channel `channel`.
+    Ops on different channels communicate independently, so that
+    independent subgraphs can be run concurrently, e.g. by ParallelExecutor.
+    Channel 0 is the default one. The same ops should be put on the
+    same channel by all parties. Only aby3 supports channels.
+    channel (int): channel id, non-negative
+    program (Program): program to which ops are appended,
+        default_main_program() if None
+    """
+    if channel < 0:
+        raise ValueError(
+            "channel should be non-negative, but got {}".format(channel))
+    if program is None:
+        program = fluid.default_main_program()
+    block = program.current_block()
+    begin = len(block.ops)
+    yield
+    for op in block.ops[begin:]:
+        op._set_attr("mpc_channel", channel)